@@ -0,0 +1,79 @@
+"""
+Measures how independent runtimes on N threads scale.
+
+Every thread calls run() on its own and drives a mix of nop operations
+and short sleeps. The sleeps leave the ring idle, which is where a
+runtime releases the GIL. On a GIL build, throughput is therefore
+bounded by a single core but no longer by the idle time of the other
+threads; on a free-threaded build it should grow with the thread count.
+
+Run this on both builds to compare:
+
+    just run python benchmarks/threads.py
+    just run python benchmarks/threads.py --threads 1 2 4 8 --ops 50000
+"""
+
+import argparse
+import sys
+import sysconfig
+import threading
+import time
+
+from boros import _impl
+
+
+async def workload(ops, batch, idle):
+    for _ in range(0, ops, batch):
+        for i in range(batch):
+            await _impl.nop(i)
+        await _impl.sleep(idle)
+
+
+def measure(nthreads, ops, batch, idle):
+    config = _impl.RunConfig()
+    config.sq_size = 64
+
+    barrier = threading.Barrier(nthreads + 1)
+
+    def worker():
+        barrier.wait()
+        _impl.run(workload(ops, batch, idle), config)
+
+    threads = [threading.Thread(target=worker) for _ in range(nthreads)]
+    for thread in threads:
+        thread.start()
+
+    barrier.wait()
+    start = time.perf_counter()
+    for thread in threads:
+        thread.join()
+
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--threads", type=int, nargs="+", default=[1, 2, 4, 8])
+    parser.add_argument("--ops", type=int, default=20000, help="nops per thread")
+    parser.add_argument("--batch", type=int, default=100, help="nops between sleeps")
+    parser.add_argument("--idle", type=float, default=0.001, help="seconds per sleep")
+    args = parser.parse_args()
+
+    free_threaded = bool(sysconfig.get_config_var("Py_GIL_DISABLED"))
+    gil_enabled = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(
+        f"Python {sys.version.split()[0]}, "
+        f"free-threaded build: {free_threaded}, GIL enabled: {gil_enabled}"
+    )
+    print(f"{'threads':>8} {'seconds':>10} {'ops/s':>12} {'speedup':>8}")
+
+    baseline = None
+    for nthreads in args.threads:
+        elapsed = measure(nthreads, args.ops, args.batch, args.idle)
+        rate = nthreads * args.ops / elapsed
+        baseline = baseline or rate
+        print(f"{nthreads:>8} {elapsed:>10.3f} {rate:>12.0f} {rate / baseline:>7.2f}x")
+
+
+if __name__ == "__main__":
+    main()
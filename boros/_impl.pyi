@@ -1,11 +1,13 @@
 # Type stubs for the native boros._impl module.
 
-from collections.abc import Awaitable, Coroutine
+from collections.abc import AsyncIterator, Awaitable, Buffer, Coroutine, Generator, Iterable
 from os import PathLike
 from socket import AddressFamily
-from typing import Any, Literal, TypeAlias, TypeVar, overload
+from typing import Any, Generic, Literal, TypeAlias, TypeVar, overload
 
 _RunT = TypeVar("_RunT")
+_TaskT = TypeVar("_TaskT")
+_AwaitableT = TypeVar("_AwaitableT", bound=Awaitable[Any])
 
 _PathT: TypeAlias = str | bytes | PathLike[str] | PathLike[bytes]
 
@@ -16,7 +18,7 @@ _SockAddrV6T: TypeAlias = (
 )
 _SockAddrT: TypeAlias = _SockAddrV4T | _SockAddrV6T | _PathT
 
-class Task:
+class Task(Generic[_TaskT]):
     """
     A lightweight, concurrent thread of execution.
 
@@ -24,6 +26,10 @@ class Task:
     instead of the OS scheduler. This makes them cheap to create and there is
     little overhead to switching between tasks.
 
+    Awaiting a task suspends until its coroutine finished, and then returns
+    its result or raises its exception. Any number of tasks may await the
+    same task, at any time.
+
     :class:`Task` has no public constructor and appears immutable to Python code.
     Its public members are mostly useful for introspection and debugging.
     """
@@ -34,10 +40,29 @@ class Task:
         ...
 
     @property
-    def coro(self) -> Coroutine[Any, Any, Any]:
+    def coro(self) -> Coroutine[Any, Any, _TaskT]:
         """The coroutine object associated with the task."""
         ...
 
+    @property
+    def done(self) -> bool:
+        """Whether the coroutine of the task has finished."""
+        ...
+
+    def __await__(self) -> Generator[Any, None, _TaskT]: ...
+
+
+def spawn(coro: Coroutine[Any, Any, _TaskT], name: Any = None, /) -> Task[_TaskT]:
+    """
+    Runs a coroutine as a new task on the current runtime.
+
+    The task is appended to the run queue and starts on the next scheduler
+    step. The returned :class:`Task` can be awaited for the result.
+    Exceptions of tasks that nobody awaits are reported through
+    :func:`sys.unraisablehook` once the task is gone.
+    """
+    ...
+
 
 class RunConfig:
     """
@@ -53,8 +78,43 @@ class RunConfig:
     cq_size: int
     #: The number of direct descriptors managed by this ring instance.
     ftable_size: int
+    #: The number of buffers in the provided buffer ring, or 0 to disable it.
+    pbuf_count: int
+    #: The size in bytes of each buffer in the provided buffer ring.
+    pbuf_size: int
+    #: The number of registered fixed buffers, or 0 to disable them.
+    fbuf_count: int
+    #: The size in bytes of each registered fixed buffer.
+    fbuf_size: int
     #: The fd of an existing io_uring instance whose work queue should be shared.
     wqfd: int
+    #: The number of task resumes before the ring is serviced again, or 0 for no limit.
+    step_budget: int
+    #: The number of awaits a task may complete without yielding, or 0 for no limit.
+    task_budget: int
+    #: The number of worker threads, more than 1 requires a free-threaded build.
+    workers: int
+    #: Whether the runtime outlives run() for reuse by the next compatible run on this thread.
+    persistent: bool
+
+
+class LeasedBuffer:
+    """
+    A buffer on loan from the runtime's buffer pool.
+
+    The buffer supports the buffer protocol and can be viewed with
+    memoryview without copying. Call release() when done with the
+    data to return the buffer to the pool for reuse by the kernel.
+    """
+
+    def release(self) -> None:
+        """Returns the buffer to its pool. Further access is invalid."""
+        ...
+
+    def __len__(self) -> int: ...
+    def __buffer__(self, flags: int, /) -> memoryview: ...
+    def __enter__(self) -> LeasedBuffer: ...
+    def __exit__(self, *args: object) -> None: ...
 
 
 class StatxResult:
@@ -103,33 +163,248 @@ def nop(echo: int) -> Awaitable[int]:
     ...
 
 
-def socket(domain: int, type: int, protocol: int) -> Awaitable[int]:
-    """Asynchronous socket(2) operation on the io_uring."""
+class Channel:
+    """
+    Receives messages posted by :func:`msg_ring` from any runtime.
+
+    Awaiting the channel returns the next message, or suspends until one
+    arrives. Only tasks on the runtime that created the channel may receive.
+    """
+
+    @property
+    def pending(self) -> int:
+        """The number of messages that arrived but were not received yet."""
+        ...
+
+    @property
+    def load(self) -> int:
+        """The number of descriptors handed to the channel and not released yet."""
+        ...
+
+    def release(self) -> None:
+        """Reports that a descriptor handed to the channel was closed."""
+        ...
+
+    def __await__(self) -> Generator[Any, None, int]: ...
+
+
+class Dispatcher:
+    """
+    Picks the channel that receives the next handed off descriptor.
+
+    Channels are picked in turn, or by their load when the dispatcher
+    was created with least_loaded set.
+    """
+
+    def pick(self) -> Channel:
+        """Returns the channel to hand the next descriptor to."""
+        ...
+
+
+def channel() -> Channel:
+    """Creates a channel that receives messages on the current runtime."""
+    ...
+
+
+def msg_ring(channel: Channel, message: int, /) -> Awaitable[None]:
+    """Posts a 32-bit message into the ring of the runtime that owns a channel."""
+    ...
+
+
+def send_fd(channel: Channel, fd: int, /) -> Awaitable[None]:
+    """
+    Installs a direct descriptor into the file table of the runtime that owns a channel.
+
+    The receiving runtime allocates a free slot in its table and gets its
+    index as the next message on the channel. The descriptor stays in the
+    table of the sender as well, chain the operation with a direct
+    :func:`close` to move it instead.
+    """
+    ...
+
+
+def dispatcher(channels: Iterable[Channel], least_loaded: bool = False, /) -> Dispatcher:
+    """Creates a dispatcher that spreads descriptor handoffs over channels."""
+    ...
+
+
+def sleep(seconds: float, /) -> Awaitable[None]:
+    """
+    Suspends the current task for the given number of seconds.
+
+    Timers have millisecond resolution and never expire early. A
+    non-positive duration yields to the other ready tasks instead.
+    """
+    ...
+
+
+def sleep_until(deadline: float, /) -> Awaitable[None]:
+    """
+    Suspends the current task until a deadline on the time.monotonic() clock.
+
+    Deadlines that already passed yield to the other ready tasks instead.
+    """
+    ...
+
+
+def chain(ops: Iterable[Awaitable[Any]], hard: bool = False, /) -> Awaitable[tuple[Any, ...]]:
+    """
+    Links operations into a chain which the kernel runs in order.
+
+    All operations are submitted back-to-back with ``IOSQE_IO_LINK`` and
+    the chain is awaited once. The result holds the value of each
+    operation, or the exception it failed with. When an operation fails,
+    the remaining ones are cancelled unless ``hard`` links are used.
+    """
+    ...
+
+
+def freelist_stats() -> dict[str, int]:
+    """
+    Returns hit and miss counters of the Operation freelist.
+
+    Memory of dead operations is recycled for new ones of the same size.
+    The ``cached`` entry holds the number of objects currently kept.
+    """
+    ...
+
+
+def timeout(op: _AwaitableT, seconds: float, /) -> _AwaitableT:
+    """
+    Attaches a deadline in seconds to an operation before it is awaited.
+
+    The deadline is enforced by the kernel through a linked timeout. When
+    it expires first, the operation is cancelled and raises :class:`TimeoutError`.
+    Returns the same operation object.
+    """
+    ...
+
+
+def socket(domain: int, type: int, protocol: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous socket(2) operation on the io_uring.
+
+    With ``direct``, the socket is installed into the ring's file table
+    and a direct descriptor index is returned instead of a regular fd.
+    """
+    ...
+
+
+def read(fd: int, count: int, offset: int, direct: bool = False, /) -> Awaitable[bytes]:
+    """
+    Asynchronous read(2) operation on the io_uring.
+
+    With ``direct``, ``fd`` is interpreted as a direct descriptor index.
+    """
+    ...
+
+
+def readinto(fd: int, buf: Buffer, count: int, offset: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous read(2) operation into a caller-supplied writable buffer.
+
+    Reads up to ``count`` bytes into the start of ``buf``, which stays
+    locked against resizing until the read completed. Slice a
+    :class:`memoryview` to read into the middle of a larger buffer.
+    Returns the number of bytes read.
+    """
+    ...
+
+
+def write(fd: int, buf: Buffer, offset: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous write(2) operation on the io_uring.
+
+    Accepts any contiguous buffer object, which stays locked against
+    resizing until the write completed. Writing a :class:`memoryview`
+    slice of a larger buffer does not copy it.
+
+    With ``direct``, ``fd`` is interpreted as a direct descriptor index.
+    """
+    ...
+
+
+def readv(fd: int, bufs: Iterable[Buffer], offset: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous readv(2) operation scattering into writable buffers.
+
+    Fills the buffers in ``bufs`` in order with a single submission.
+    All buffers stay locked against resizing until the read completed.
+    Returns the total number of bytes read.
+    """
+    ...
+
+
+def writev(fd: int, bufs: Iterable[Buffer], offset: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous writev(2) operation gathering from buffers.
+
+    Writes the buffers in ``bufs`` in order with a single submission,
+    without joining them first. All buffers stay locked against resizing
+    until the write completed. Returns the total number of bytes written.
+    """
+    ...
+
+
+def lease_fixed() -> LeasedBuffer:
+    """
+    Leases a slot from the runtime's registered fixed buffers.
+
+    The buffer spans the whole slot and can be passed to :func:`read_fixed`
+    and :func:`write_fixed`. Requires :attr:`RunConfig.fbuf_count` to be
+    set; fails with ``ENOBUFS`` when all slots are on loan.
+    """
     ...
 
 
-def read(fd: int, count: int, offset: int) -> Awaitable[bytes]:
-    """Asynchronous read(2) operation on the io_uring."""
+def read_fixed(fd: int, buf: LeasedBuffer, count: int, offset: int) -> Awaitable[int]:
+    """
+    Asynchronous read(2) operation into a registered fixed buffer.
+
+    Reads up to ``count`` bytes into the start of ``buf`` and returns the
+    number of bytes read. The buffer cannot be released while in flight.
+    """
     ...
 
 
-def write(fd: int, buf: bytes, offset: int) -> Awaitable[int]:
-    """Asynchronous write(2) operation on the io_uring."""
+def write_fixed(fd: int, buf: LeasedBuffer, count: int, offset: int) -> Awaitable[int]:
+    """
+    Asynchronous write(2) operation from a registered fixed buffer.
+
+    Writes the first ``count`` bytes of ``buf`` and returns the number of
+    bytes written. The buffer cannot be released while in flight.
+    """
     ...
 
 
-def close(fd: int) -> Awaitable[int]:
-    """Asynchronous close(2) operation on the io_uring."""
+def close(fd: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous close(2) operation on the io_uring.
+
+    With ``direct``, the direct descriptor index is removed from the
+    ring's file table instead.
+    """
     ...
 
 
-def openat(dfd: int | None, path: _PathT, flags: int, mode: int) -> Awaitable[int]:
-    """Asynchronous openat(2) operation on the io_uring."""
+def openat(
+    dfd: int | None, path: _PathT, flags: int, mode: int, direct: bool = False, /
+) -> Awaitable[int]:
+    """
+    Asynchronous openat(2) operation on the io_uring.
+
+    With ``direct``, the file is installed into the ring's file table
+    and a direct descriptor index is returned instead of a regular fd.
+    """
     ...
 
 
-def cancel_fd(fd: int) -> Awaitable[int]:
-    """Asynchronously cancels all operations on a fd."""
+def cancel_fd(fd: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronously cancels all operations on a fd.
+
+    With ``direct``, ``fd`` is interpreted as a direct descriptor index.
+    """
     ...
 
 
@@ -217,8 +492,33 @@ def connect(fd: int, af: int, address: _SockAddrT) -> Awaitable[None]:
     ...
 
 
-def accept(fd: int, flags: int) -> Awaitable[tuple[int, _SockAddrT]]:
-    """Asynchronous accept(2) operation on the io_uring."""
+def accept(
+    fd: int, flags: int, direct: bool = False, /
+) -> Awaitable[tuple[int, _SockAddrT]]:
+    """
+    Asynchronous accept(2) operation on the io_uring.
+
+    With ``direct``, the connection is installed into the ring's file
+    table and a direct descriptor index is returned instead of a regular fd.
+    """
+    ...
+
+
+def accept_multishot(
+    fd: int, flags: int, peername: bool = False, /
+) -> AsyncIterator[tuple[int, _SockAddrT | None]]:
+    """
+    Multishot accept(2) operation on the io_uring, consumed with async for.
+
+    A single submission keeps accepting connections until it is cancelled,
+    which ends the iteration. The kernel may drop the submission at any
+    time; it is re-armed transparently on the next iteration.
+
+    The address is ``None`` unless ``peername`` is set. Looking it up costs
+    a blocking getpeername(2) call per connection, which adds up under high
+    connection rates. It is also ``None`` if the peer disconnected before
+    it could be queried.
+    """
     ...
 
 
@@ -249,13 +549,141 @@ def listen(fd: int, backlog: int) -> Awaitable[None]:
     """Asynchronous listen(2) operation on the io_uring."""
     ...
 
-def send(fd: int, buf: bytes, flags: int) -> Awaitable[int]:
-    """Asynchronous send(2) operation on the io_uring."""
+def send(fd: int, buf: Buffer, flags: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous send(2) operation on the io_uring.
+
+    Accepts any contiguous buffer object, which stays locked against
+    resizing until the send completed.
+
+    With ``direct``, ``fd`` is interpreted as a direct descriptor index.
+    """
+    ...
+
+
+def sendmsg(fd: int, bufs: Iterable[Buffer], flags: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous sendmsg(2) operation gathering from buffers.
+
+    Sends the buffers in ``bufs`` in order as one message, without
+    joining them first. Returns the total number of bytes sent.
+    """
+    ...
+
+
+def send_zc(fd: int, buf: Buffer, flags: int) -> Awaitable[int]:
+    """
+    Asynchronous zero-copy send(2) operation on the io_uring.
+
+    The kernel transmits straight from ``buf`` instead of copying it into
+    socket buffers, which pays off for large payloads. The task resumes
+    as soon as the send completes, but ``buf`` stays locked against
+    resizing until the kernel signals that it no longer needs the pages.
+    """
+    ...
+
+
+def sendfile(out_fd: int, in_fd: int, offset: int, count: int, /) -> Awaitable[int]:
+    """
+    Streams ``count`` bytes of a file starting at ``offset`` into a socket.
+
+    The data is spliced through a pipe from a per-runtime pool and never
+    enters userspace. Partial transfers are continued internally, so the
+    operation completes once with the total number of bytes sent. That is
+    less than ``count`` only when the file ends early. The file position
+    of ``in_fd`` is not changed.
+    """
+    ...
+
+
+def recv(fd: int, count: int, flags: int, direct: bool = False, /) -> Awaitable[bytes]:
+    """
+    Asynchronous recv(2) operation on the io_uring.
+
+    With ``direct``, ``fd`` is interpreted as a direct descriptor index.
+    """
+    ...
+
+
+def recv_into(fd: int, buf: Buffer, count: int, flags: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous recv(2) operation into a caller-supplied writable buffer.
+
+    Receives up to ``count`` bytes into the start of ``buf``, which stays
+    locked against resizing until the receive completed. Returns the
+    number of bytes received.
+    """
+    ...
+
+
+def recvmsg(fd: int, bufs: Iterable[Buffer], flags: int, direct: bool = False, /) -> Awaitable[int]:
+    """
+    Asynchronous recvmsg(2) operation scattering into writable buffers.
+
+    Fills the buffers in ``bufs`` in order from one message and returns
+    the total number of bytes received.
+    """
+    ...
+
+
+def recv_buffer(fd: int, flags: int) -> Awaitable[LeasedBuffer]:
+    """
+    Asynchronous recv(2) operation into a buffer from the provided buffer ring.
+
+    No memory is reserved while the operation waits for data. The kernel
+    picks a buffer only when data arrives. Requires :attr:`RunConfig.pbuf_count`
+    to be set; fails with ``ENOBUFS`` when all buffers are on loan.
+    """
     ...
 
 
-def recv(fd: int, count: int, flags: int) -> Awaitable[bytes]:
-    """Asynchronous recv(2) operation on the io_uring."""
+def recv_multishot(fd: int, flags: int) -> AsyncIterator[LeasedBuffer]:
+    """
+    Multishot recv(2) operation into provided buffers, consumed with async for.
+
+    Yields a :class:`LeasedBuffer` for every chunk of received data until
+    the peer closes the connection. Requires :attr:`RunConfig.pbuf_count`
+    to be set. Releasing buffers promptly keeps the stream flowing.
+    """
+    ...
+
+
+def splice(fd_in: int, off_in: int, fd_out: int, off_out: int, nbytes: int, flags: int, /) -> Awaitable[int]:
+    """
+    Asynchronous splice(2) operation on the io_uring.
+
+    Moves up to ``nbytes`` between two descriptors without copying them
+    through userspace. One of them must be a pipe. An offset of ``-1``
+    uses and advances the current file position. Returns the number of
+    bytes moved.
+    """
+    ...
+
+
+def tee(fd_in: int, fd_out: int, nbytes: int, flags: int, /) -> Awaitable[int]:
+    """
+    Asynchronous tee(2) operation on the io_uring.
+
+    Duplicates up to ``nbytes`` from one pipe into another without
+    consuming them. Returns the number of bytes duplicated.
+    """
+    ...
+
+
+def relay(fd_a: int, fd_b: int, /) -> Awaitable[tuple[int, int]]:
+    """
+    Pumps data between two descriptors in both directions.
+
+    Data moves through internal pipes with linked splice operations and
+    never enters Python. When one side reaches end of file, the relay
+    shuts down the other side for writing. Completes once both directions
+    are done, with the number of bytes moved from ``fd_a`` to ``fd_b``
+    and from ``fd_b`` to ``fd_a``.
+
+    The first error stops both directions and is raised. A relay can't
+    be chained or given a timeout, and shutting down one of the sockets
+    is the way to end it early.
+    """
     ...
 
 
@@ -301,3 +729,14 @@ def run(coro: Coroutine[Any, None, _RunT], conf: RunConfig) -> _RunT:
     This is the entrypoint to the boros runtime.
     """
     ...
+
+
+def shutdown() -> None:
+    """
+    Destroys the runtime that a persistent run kept on the current thread.
+
+    Threads which ran with :attr:`RunConfig.persistent` set should call
+    this before they exit, or the ring stays open until the process ends.
+    Does nothing if there is no such runtime.
+    """
+    ...
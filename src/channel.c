@@ -0,0 +1,407 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "channel.h"
+
+#include <limits.h>
+#include <stddef.h>
+
+#include "driver/handle.h"
+#include "module.h"
+
+/* Initial number of messages a channel buffers before it grows. */
+#define CHANNEL_INITIAL_CAPACITY 16
+
+static bool channel_push(Channel *self, int message) {
+    if (self->count == self->capacity) {
+        size_t capacity = self->capacity != 0 ? self->capacity * 2 : CHANNEL_INITIAL_CAPACITY;
+
+        int *messages = PyMem_Calloc(capacity, sizeof(int));
+        if (messages == NULL) {
+            PyErr_NoMemory();
+            return false;
+        }
+
+        /* Unwrap the ring buffer into the front of the new one. */
+        for (size_t i = 0; i < self->count; ++i) {
+            messages[i] = self->messages[(self->head + i) % self->capacity];
+        }
+
+        PyMem_Free(self->messages);
+        self->messages = messages;
+        self->head     = 0;
+        self->capacity = capacity;
+    }
+
+    self->messages[(self->head + self->count) % self->capacity] = message;
+    ++self->count;
+    return true;
+}
+
+static int channel_pop(Channel *self) {
+    assert(self->count > 0);
+
+    int message = self->messages[self->head];
+    self->head  = (self->head + 1) % self->capacity;
+    --self->count;
+    return message;
+}
+
+PyObject *channel_create(PyObject *mod, PyObject *args) {
+    (void)args;
+    ImplState *state = PyModule_GetState(mod);
+
+    RuntimeHandle *rt = runtime_get_local(state);
+    if (rt == NULL) {
+        return NULL;
+    }
+
+    Channel *channel = (Channel *)python_alloc(state->Channel_type);
+    if (channel != NULL) {
+        channel->owner      = rt;
+        channel->generation = rt->proactor.generation;
+        channel->ring_fd    = rt->proactor.ring.ring_fd;
+        channel->messages   = NULL;
+        channel->head       = 0;
+        channel->count      = 0;
+        channel->capacity   = 0;
+        channel->load       = 0;
+        task_list_init(&channel->waiters);
+    }
+
+    return (PyObject *)channel;
+}
+
+void channel_park(Channel *self, RuntimeHandle *rt, Task *task) {
+    assert(self->owner == rt);
+
+    task_list_push_back(&self->waiters, task);
+    ++rt->channel_waiters;
+}
+
+void channel_deliver(Channel *self, Proactor *proactor, TaskList *list, int message) {
+    /*
+     * The runtime which created the channel is gone, and its ring's
+     * descriptor number was reused by the ring we were posted to.
+     */
+    if (!channel_owned_by(self, proactor)) {
+        return;
+    }
+
+    if (!channel_push(self, message)) {
+        PyErr_WriteUnraisable((PyObject *)self);
+        return;
+    }
+
+    /*
+     * A woken task receives the message when it resumes, unless another
+     * task took it first. Then it goes back to waiting for the next one.
+     */
+    if (!task_list_empty(&self->waiters)) {
+        Task *task = task_list_pop_front(&self->waiters);
+        task_list_push_back(list, task);
+        Py_DECREF(task);
+
+        assert(self->owner->channel_waiters > 0);
+        --self->owner->channel_waiters;
+    }
+}
+
+PyDoc_STRVAR(g_channel_doc, "Receives messages posted by msg_ring() from any runtime.\n\n"
+                            "Awaiting the channel returns the next message, or suspends until one\n"
+                            "arrives. Only tasks on the runtime that created the channel may receive.");
+
+PyDoc_STRVAR(g_channel_pending_doc, "The number of messages that arrived but were not received yet.");
+
+static PyObject *channel_pending_get(PyObject *self, void *Py_UNUSED(closure)) {
+    Channel *channel = (Channel *)self;
+    return PyLong_FromSize_t(channel->count);
+}
+
+PyDoc_STRVAR(g_channel_load_doc, "The number of descriptors handed to the channel and not released yet.");
+
+static PyObject *channel_load_get(PyObject *self, void *Py_UNUSED(closure)) {
+    Channel *channel = (Channel *)self;
+    return PyLong_FromLong(__atomic_load_n(&channel->load, __ATOMIC_RELAXED));
+}
+
+static PyGetSetDef g_channel_properties[] = {
+    {"pending", channel_pending_get, NULL, g_channel_pending_doc, NULL},
+    {"load", channel_load_get, NULL, g_channel_load_doc, NULL},
+    {NULL, NULL, NULL, NULL, NULL},
+};
+
+PyDoc_STRVAR(g_channel_release_doc, "Reports that a descriptor handed to the channel was closed.");
+
+static PyObject *channel_release(PyObject *self, PyObject *Py_UNUSED(args)) {
+    Channel *channel = (Channel *)self;
+
+    if (__atomic_load_n(&channel->load, __ATOMIC_RELAXED) <= 0) {
+        PyErr_SetString(PyExc_ValueError, "No descriptors were handed to the channel");
+        return NULL;
+    }
+
+    channel_add_load(channel, -1);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef g_channel_methods[] = {
+    {"release", channel_release, METH_NOARGS, g_channel_release_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static PySendResult channel_send(PyObject *self, PyObject *arg, PyObject **presult) {
+    Channel *channel = (Channel *)self;
+    ImplState *state = PyType_GetModuleState(Py_TYPE(self));
+    (void)arg;
+
+    *presult = NULL;
+
+    RuntimeHandle *rt = runtime_get_local(state);
+    if (rt == NULL) {
+        return PYGEN_ERROR;
+    }
+
+    /* Messages only ever arrive on the ring of the owning runtime. */
+    if (!channel_owned_by(channel, &rt->proactor)) {
+        PyErr_SetString(PyExc_RuntimeError, "Channel belongs to another runtime");
+        return PYGEN_ERROR;
+    }
+
+    if (channel->count == 0) {
+        *presult = Py_NewRef(self);
+        return PYGEN_NEXT;
+    }
+
+    /* Draining a busy channel in a loop must not starve the others. */
+    if (!runtime_coop_consume(state)) {
+        *presult = Py_NewRef(Py_None);
+        return PYGEN_NEXT;
+    }
+
+    *presult = PyLong_FromLong(channel_pop(channel));
+    return *presult != NULL ? PYGEN_RETURN : PYGEN_ERROR;
+}
+
+static PyObject *channel_iternext(PyObject *self) {
+    PyObject *res;
+
+    switch (channel_send(self, Py_None, &res)) {
+    case PYGEN_NEXT:
+        return res;
+    case PYGEN_RETURN:
+        python_stop_iteration(res);
+        return NULL;
+    default:
+        return NULL;
+    }
+}
+
+static int channel_traverse(PyObject *self, visitproc visit, void *arg) {
+    Channel *channel = (Channel *)self;
+
+    Py_VISIT(Py_TYPE(self));
+
+    for (TaskLink *link = channel->waiters.head.next; link != &channel->waiters.head; link = link->next) {
+        Py_VISIT((PyObject *)((uint8_t *)link - offsetof(Task, link)));
+    }
+
+    return 0;
+}
+
+static int channel_clear(PyObject *self) {
+    Channel *channel = (Channel *)self;
+    ImplState *state = PyType_GetModuleState(Py_TYPE(self));
+
+    /*
+     * Tasks only ever park on a channel of the runtime they run on. When
+     * that runtime is still the active one, it must stop counting them
+     * as waiters, or it would never notice the deadlock they are in.
+     */
+    RuntimeHandle *rt = PyThread_tss_get(state->local_handle);
+    bool owned        = rt != NULL && rt->active && channel_owned_by(channel, &rt->proactor);
+
+    while (!task_list_empty(&channel->waiters)) {
+        Task *task = task_list_pop_front(&channel->waiters);
+        if (owned) {
+            assert(rt->channel_waiters > 0);
+            --rt->channel_waiters;
+        }
+
+        Py_DECREF(task);
+    }
+
+    PyMem_Free(channel->messages);
+    channel->messages = NULL;
+    channel->count    = 0;
+    channel->capacity = 0;
+    return 0;
+}
+
+// clang-format off
+static PyType_Slot g_channel_slots[] = {
+    {Py_tp_doc, (void *)g_channel_doc},
+    {Py_tp_dealloc, python_tp_dealloc},
+    {Py_tp_traverse, channel_traverse},
+    {Py_tp_clear, channel_clear},
+    {Py_tp_getset, g_channel_properties},
+    {Py_tp_methods, g_channel_methods},
+    {Py_tp_iter, PyObject_SelfIter},
+    {Py_tp_iternext, channel_iternext},
+    {Py_am_await, PyObject_SelfIter},
+    {Py_am_send, channel_send},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_channel_spec = {
+    .name      = "_impl.Channel",
+    .basicsize = sizeof(Channel),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots     = g_channel_slots,
+};
+
+PyTypeObject *channel_register(PyObject *mod) {
+    PyTypeObject *tp = (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_channel_spec, NULL);
+    if (tp == NULL) {
+        return NULL;
+    }
+
+    if (PyModule_AddType(mod, tp) < 0) {
+        return NULL;
+    }
+
+    return tp;
+}
+
+PyObject *dispatcher_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 1 && nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 1 or 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    bool least_loaded = false;
+    if (nargs == 2 && !python_parse_bool(&least_loaded, args[1])) {
+        return NULL;
+    }
+
+    PyObject *channels = PySequence_Tuple(args[0]);
+    if (channels == NULL) {
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(channels) == 0) {
+        PyErr_SetString(PyExc_ValueError, "Expected at least one Channel");
+        Py_DECREF(channels);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(channels); ++i) {
+        if (PyObject_TypeCheck(PyTuple_GET_ITEM(channels, i), state->Channel_type) == 0) {
+            PyErr_SetString(PyExc_TypeError, "Expected Channel instance");
+            Py_DECREF(channels);
+            return NULL;
+        }
+    }
+
+    Dispatcher *dispatcher = (Dispatcher *)python_alloc(state->Dispatcher_type);
+    if (dispatcher == NULL) {
+        Py_DECREF(channels);
+        return NULL;
+    }
+
+    dispatcher->channels     = channels;
+    dispatcher->cursor       = 0;
+    dispatcher->least_loaded = least_loaded;
+    return (PyObject *)dispatcher;
+}
+
+PyDoc_STRVAR(g_dispatcher_doc, "Picks the channel that receives the next handed off descriptor.\n\n"
+                               "Channels are picked in turn, or by their load when the dispatcher\n"
+                               "was created with least_loaded set.");
+
+PyDoc_STRVAR(g_dispatcher_pick_doc, "Returns the channel to hand the next descriptor to.");
+
+static PyObject *dispatcher_pick(PyObject *self, PyObject *Py_UNUSED(args)) {
+    Dispatcher *dispatcher = (Dispatcher *)self;
+
+    Py_ssize_t count = PyTuple_GET_SIZE(dispatcher->channels);
+    Py_ssize_t pick  = dispatcher->cursor;
+
+    /*
+     * Scanning from the cursor breaks ties between equally loaded
+     * channels in turn, instead of piling onto the first of them.
+     */
+    if (dispatcher->least_loaded) {
+        int best = INT_MAX;
+        for (Py_ssize_t i = 0; i < count; ++i) {
+            Py_ssize_t index = (dispatcher->cursor + i) % count;
+            Channel *channel = (Channel *)PyTuple_GET_ITEM(dispatcher->channels, index);
+
+            int load = __atomic_load_n(&channel->load, __ATOMIC_RELAXED);
+            if (load < best) {
+                best = load;
+                pick = index;
+            }
+        }
+    }
+
+    dispatcher->cursor = (pick + 1) % count;
+    return Py_NewRef(PyTuple_GET_ITEM(dispatcher->channels, pick));
+}
+
+static int dispatcher_traverse(PyObject *self, visitproc visit, void *arg) {
+    Dispatcher *dispatcher = (Dispatcher *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(dispatcher->channels);
+    return 0;
+}
+
+static int dispatcher_clear(PyObject *self) {
+    Dispatcher *dispatcher = (Dispatcher *)self;
+
+    Py_CLEAR(dispatcher->channels);
+    return 0;
+}
+
+static PyMethodDef g_dispatcher_methods[] = {
+    {"pick", dispatcher_pick, METH_NOARGS, g_dispatcher_pick_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+// clang-format off
+static PyType_Slot g_dispatcher_slots[] = {
+    {Py_tp_doc, (void *)g_dispatcher_doc},
+    {Py_tp_dealloc, python_tp_dealloc},
+    {Py_tp_traverse, dispatcher_traverse},
+    {Py_tp_clear, dispatcher_clear},
+    {Py_tp_methods, g_dispatcher_methods},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_dispatcher_spec = {
+    .name      = "_impl.Dispatcher",
+    .basicsize = sizeof(Dispatcher),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots     = g_dispatcher_slots,
+};
+
+PyTypeObject *dispatcher_register(PyObject *mod) {
+    PyTypeObject *tp = (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_dispatcher_spec, NULL);
+    if (tp == NULL) {
+        return NULL;
+    }
+
+    if (PyModule_AddType(mod, tp) < 0) {
+        return NULL;
+    }
+
+    return tp;
+}
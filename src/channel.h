@@ -0,0 +1,78 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+#include "driver/handle.h"
+#include "driver/proactor.h"
+#include "task.h"
+
+/*
+ * Receives 32-bit messages which other runtimes, possibly on other
+ * threads, post straight into the completion queue of the runtime that
+ * created the channel through IORING_OP_MSG_RING.
+ */
+typedef struct {
+    PyObject_HEAD
+    /* The runtime whose ring receives the messages, and its descriptor. */
+    RuntimeHandle *owner;
+    uint64_t generation;
+    int ring_fd;
+    /* Tasks waiting for a message, linked through their link. */
+    TaskList waiters;
+    /* A ring buffer of messages that arrived before anyone asked. */
+    int *messages;
+    size_t head;
+    size_t count;
+    size_t capacity;
+    /* Descriptors handed to the channel which were not released yet. */
+    int load;
+} Channel;
+
+/*
+ * Spreads descriptor handoffs over the channels of several runtimes,
+ * either in turn or to the one with the least load. A dispatcher is
+ * meant to be used from the single runtime that accepts connections.
+ */
+typedef struct {
+    PyObject_HEAD
+    /* A tuple of the Channel objects to pick from. */
+    PyObject *channels;
+    Py_ssize_t cursor;
+    bool least_loaded;
+} Dispatcher;
+
+/* Checks if self receives its messages on the ring of proactor. */
+static inline bool channel_owned_by(Channel *self, Proactor *proactor) {
+    return &self->owner->proactor == proactor && self->generation == proactor->generation;
+}
+
+/* Adjusts the load of self, which runtimes on any thread may do. */
+static inline void channel_add_load(Channel *self, int delta) {
+    __atomic_fetch_add(&self->load, delta, __ATOMIC_RELAXED);
+}
+
+/* Creates a channel that receives messages on the current runtime. */
+PyObject *channel_create(PyObject *mod, PyObject *args);
+
+/*
+ * Suspends task until the next message arrives on self. The task counts
+ * as a waiter of rt, which keeps its loop waiting for messages.
+ */
+void channel_park(Channel *self, RuntimeHandle *rt, Task *task);
+
+/*
+ * Buffers a message that arrived on the ring of proactor and moves
+ * the first waiting task to list. Messages which arrive on a ring
+ * that does not own the channel are dropped.
+ */
+void channel_deliver(Channel *self, Proactor *proactor, TaskList *list, int message);
+
+PyTypeObject *channel_register(PyObject *mod);
+
+/* Creates a dispatcher over a sequence of channels. */
+PyObject *dispatcher_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
+PyTypeObject *dispatcher_register(PyObject *mod);
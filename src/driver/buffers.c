@@ -0,0 +1,465 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "driver/buffers.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <sys/uio.h>
+
+#include "driver/handle.h"
+#include "module.h"
+
+/* BufferPool implementation */
+
+static inline char *buffer_pool_address(BufferPool *self, int bid) {
+    return self->memory + (size_t)bid * self->bufsize;
+}
+
+static bool buffer_pool_init(BufferPool *self, BufferRecycleFn recycle, unsigned int nentries, unsigned int bufsize) {
+    self->recycle  = recycle;
+    self->nentries = nentries;
+    self->bufsize  = bufsize;
+
+    self->memory = PyMem_Malloc((size_t)nentries * bufsize);
+    if (self->memory == NULL) {
+        PyErr_SetNone(PyExc_MemoryError);
+        return false;
+    }
+
+    return true;
+}
+
+LeasedBuffer *buffer_pool_lease(BufferPool *self, int bid, Py_ssize_t len) {
+    ImplState *state = PyType_GetModuleState(Py_TYPE(self));
+
+    LeasedBuffer *lease = (LeasedBuffer *)python_alloc(state->LeasedBuffer_type);
+    if (lease != NULL) {
+        lease->pool    = (BufferPool *)Py_NewRef(self);
+        lease->data    = bid >= 0 ? buffer_pool_address(self, bid) : self->memory;
+        lease->len     = len;
+        lease->exports = 0;
+        lease->bid     = bid;
+    } else if (bid >= 0) {
+        /* Don't leak the buffer when we can't give it out. */
+        self->recycle(self, bid);
+    }
+
+    return lease;
+}
+
+static int buffer_pool_traverse(PyObject *self, visitproc visit, void *arg) {
+    Py_VISIT(Py_TYPE(self));
+    return 0;
+}
+
+static int buffer_pool_clear(PyObject *self) {
+    (void)self;
+    return 0;
+}
+
+/* BufferRing implementation */
+
+static void buffer_ring_recycle(BufferPool *pool, int bid) {
+    BufferRing *self = (BufferRing *)pool;
+
+    /* Once detached from the runtime, buffers are never handed out again. */
+    if (self->br == NULL) {
+        return;
+    }
+
+    int mask = io_uring_buf_ring_mask(pool->nentries);
+    io_uring_buf_ring_add(self->br, buffer_pool_address(pool, bid), pool->bufsize, bid, mask, 0);
+    io_uring_buf_ring_advance(self->br, 1);
+}
+
+BufferRing *buffer_ring_create(ImplState *state, struct io_uring *ring, RunConfig *config) {
+    int res;
+    unsigned int nentries = config->pbuf_count;
+
+    /* The kernel requires a power of two that fits into a 16-bit buffer id. */
+    if (nentries == 0 || nentries > 32768 || (nentries & (nentries - 1)) != 0) {
+        PyErr_SetString(PyExc_ValueError, "pbuf_count must be a power of two no larger than 32768");
+        return NULL;
+    }
+
+    if (config->pbuf_size == 0) {
+        PyErr_SetString(PyExc_ValueError, "pbuf_size must be non-zero when pbuf_count is set");
+        return NULL;
+    }
+
+    BufferRing *self = (BufferRing *)python_alloc(state->BufferRing_type);
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->ring = NULL;
+    self->br   = NULL;
+    self->bgid = 0;
+
+    if (!buffer_pool_init(&self->base, buffer_ring_recycle, nentries, config->pbuf_size)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    self->br = io_uring_setup_buf_ring(ring, nentries, self->bgid, 0, &res);
+    if (self->br == NULL) {
+        Py_DECREF(self);
+        errno = -res;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+    self->ring = ring;
+
+    /* Hand all buffers over to the kernel initially. */
+    int mask = io_uring_buf_ring_mask(nentries);
+    for (unsigned int bid = 0; bid < nentries; ++bid) {
+        io_uring_buf_ring_add(self->br, buffer_pool_address(&self->base, bid), self->base.bufsize, bid, mask, bid);
+    }
+    io_uring_buf_ring_advance(self->br, nentries);
+
+    return self;
+}
+
+void buffer_ring_detach(BufferRing *self) {
+    if (self->br != NULL) {
+        io_uring_free_buf_ring(self->ring, self->br, self->base.nentries, self->bgid);
+        self->br   = NULL;
+        self->ring = NULL;
+    }
+}
+
+static void buffer_ring_dealloc(PyObject *self) {
+    BufferRing *pool = (BufferRing *)self;
+
+    /* The runtime must detach the ring before dropping its reference. */
+    assert(pool->br == NULL);
+    PyMem_Free(pool->base.memory);
+
+    python_tp_dealloc(self);
+}
+
+// clang-format off
+static PyType_Slot g_buffer_ring_slots[] = {
+    {Py_tp_dealloc, buffer_ring_dealloc},
+    {Py_tp_traverse, buffer_pool_traverse},
+    {Py_tp_clear, buffer_pool_clear},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_buffer_ring_spec = {
+    .name      = "_impl._BufferRing",
+    .basicsize = sizeof(BufferRing),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots     = g_buffer_ring_slots,
+};
+
+PyTypeObject *buffer_ring_register(PyObject *mod) {
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_buffer_ring_spec, NULL);
+}
+
+/* FixedBufferPool implementation */
+
+static void fixed_buffer_pool_recycle(BufferPool *pool, int bid) {
+    FixedBufferPool *self = (FixedBufferPool *)pool;
+
+    /* Once detached from the runtime, buffers are never handed out again. */
+    if (self->ring == NULL) {
+        return;
+    }
+
+    assert(self->nfree < pool->nentries);
+    self->freelist[self->nfree++] = bid;
+}
+
+FixedBufferPool *fixed_buffer_pool_create(ImplState *state, struct io_uring *ring, RunConfig *config) {
+    unsigned int nentries = config->fbuf_count;
+
+    if (config->fbuf_size == 0) {
+        PyErr_SetString(PyExc_ValueError, "fbuf_size must be non-zero when fbuf_count is set");
+        return NULL;
+    }
+
+    FixedBufferPool *self = (FixedBufferPool *)python_alloc(state->FixedBufferPool_type);
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->ring     = NULL;
+    self->freelist = NULL;
+    self->nfree    = 0;
+
+    if (!buffer_pool_init(&self->base, fixed_buffer_pool_recycle, nentries, config->fbuf_size)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    self->freelist  = PyMem_Calloc(nentries, sizeof(int));
+    struct iovec *v = PyMem_Calloc(nentries, sizeof(struct iovec));
+    if (self->freelist == NULL || v == NULL) {
+        PyMem_Free(v);
+        Py_DECREF(self);
+        PyErr_SetNone(PyExc_MemoryError);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i < nentries; ++i) {
+        v[i].iov_base = buffer_pool_address(&self->base, i);
+        v[i].iov_len  = self->base.bufsize;
+    }
+
+    int res = io_uring_register_buffers(ring, v, nentries);
+    PyMem_Free(v);
+    if (res < 0) {
+        Py_DECREF(self);
+        errno = -res;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+    self->ring = ring;
+
+    /* Hand out the lowest slots first. */
+    for (unsigned int i = 0; i < nentries; ++i) {
+        self->freelist[i] = nentries - i - 1;
+    }
+    self->nfree = nentries;
+
+    return self;
+}
+
+void fixed_buffer_pool_detach(FixedBufferPool *self) {
+    if (self->ring != NULL) {
+        io_uring_unregister_buffers(self->ring);
+        self->ring  = NULL;
+        self->nfree = 0;
+    }
+}
+
+LeasedBuffer *fixed_buffer_pool_acquire(FixedBufferPool *self) {
+    if (self->nfree == 0) {
+        errno = ENOBUFS;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return NULL;
+    }
+
+    int bid = self->freelist[--self->nfree];
+    return buffer_pool_lease(&self->base, bid, self->base.bufsize);
+}
+
+PyObject *fixed_buffer_lease(PyObject *mod, PyObject *Py_UNUSED(args)) {
+    ImplState *state = PyModule_GetState(mod);
+
+    RuntimeHandle *rt = runtime_get_local(state);
+    if (rt == NULL) {
+        return NULL;
+    }
+
+    if (rt->fixed_buffers == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "No fixed buffers configured, set RunConfig.fbuf_count");
+        return NULL;
+    }
+
+    return (PyObject *)fixed_buffer_pool_acquire(rt->fixed_buffers);
+}
+
+LeasedBuffer *fixed_buffer_pin(ImplState *state, PyObject *ob, unsigned int nbytes) {
+    if (!Py_IS_TYPE(ob, state->LeasedBuffer_type)) {
+        PyErr_SetString(PyExc_TypeError, "Expected variable of type LeasedBuffer");
+        return NULL;
+    }
+
+    LeasedBuffer *lease = (LeasedBuffer *)ob;
+    if (lease->pool == NULL || !Py_IS_TYPE(lease->pool, state->FixedBufferPool_type)) {
+        PyErr_SetString(PyExc_ValueError, "Buffer was not leased from the fixed buffer pool");
+        return NULL;
+    }
+
+    if (lease->data == NULL || ((FixedBufferPool *)lease->pool)->ring == NULL) {
+        PyErr_SetString(PyExc_ValueError, "Operation on released buffer");
+        return NULL;
+    }
+
+    if (nbytes > lease->len) {
+        PyErr_Format(PyExc_ValueError, "Buffer holds %zd bytes, got %u", lease->len, nbytes);
+        return NULL;
+    }
+
+    ++lease->exports;
+    return (LeasedBuffer *)Py_NewRef(lease);
+}
+
+void fixed_buffer_unpin(LeasedBuffer *self) {
+    --self->exports;
+}
+
+static void fixed_buffer_pool_dealloc(PyObject *self) {
+    FixedBufferPool *pool = (FixedBufferPool *)self;
+
+    /* The runtime must detach the pool before dropping its reference. */
+    assert(pool->ring == NULL);
+    PyMem_Free(pool->freelist);
+    PyMem_Free(pool->base.memory);
+
+    python_tp_dealloc(self);
+}
+
+// clang-format off
+static PyType_Slot g_fixed_buffer_pool_slots[] = {
+    {Py_tp_dealloc, fixed_buffer_pool_dealloc},
+    {Py_tp_traverse, buffer_pool_traverse},
+    {Py_tp_clear, buffer_pool_clear},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_fixed_buffer_pool_spec = {
+    .name      = "_impl._FixedBufferPool",
+    .basicsize = sizeof(FixedBufferPool),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots     = g_fixed_buffer_pool_slots,
+};
+
+PyTypeObject *fixed_buffer_pool_register(PyObject *mod) {
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_fixed_buffer_pool_spec, NULL);
+}
+
+/* LeasedBuffer implementation */
+
+PyDoc_STRVAR(g_leased_buffer_doc, "A buffer on loan from the runtime's buffer pool.\n\n"
+                                  "The buffer supports the buffer protocol and can be viewed with\n"
+                                  "memoryview without copying. Call release() when done with the\n"
+                                  "data to return the buffer to the pool for reuse by the kernel.");
+PyDoc_STRVAR(g_leased_buffer_release_doc, "Returns the buffer to its pool. Further access is invalid.");
+
+static bool leased_buffer_release_impl(LeasedBuffer *self) {
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError, "Cannot release a buffer while it is still exported");
+        return false;
+    }
+
+    if (self->bid >= 0 && self->pool != NULL) {
+        self->pool->recycle(self->pool, self->bid);
+        self->bid = -1;
+    }
+
+    self->data = NULL;
+    self->len  = 0;
+    return true;
+}
+
+static PyObject *leased_buffer_release(PyObject *self, PyObject *Py_UNUSED(args)) {
+    if (!leased_buffer_release_impl((LeasedBuffer *)self)) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *leased_buffer_enter(PyObject *self, PyObject *Py_UNUSED(args)) {
+    return Py_NewRef(self);
+}
+
+static PyObject *leased_buffer_exit(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    (void)args;
+    (void)nargs;
+
+    return leased_buffer_release(self, NULL);
+}
+
+static Py_ssize_t leased_buffer_length(PyObject *self) {
+    return ((LeasedBuffer *)self)->len;
+}
+
+static int leased_buffer_getbuffer(PyObject *self, Py_buffer *view, int flags) {
+    LeasedBuffer *lease = (LeasedBuffer *)self;
+
+    if (lease->data == NULL) {
+        PyErr_SetString(PyExc_ValueError, "Operation on released buffer");
+        return -1;
+    }
+
+    if (PyBuffer_FillInfo(view, self, lease->data, lease->len, 0, flags) < 0) {
+        return -1;
+    }
+
+    ++lease->exports;
+    return 0;
+}
+
+static void leased_buffer_releasebuffer(PyObject *self, Py_buffer *view) {
+    (void)view;
+    --((LeasedBuffer *)self)->exports;
+}
+
+static void leased_buffer_dealloc(PyObject *self) {
+    LeasedBuffer *lease = (LeasedBuffer *)self;
+
+    /* Exports hold a strong reference, so there can't be any left. */
+    assert(lease->exports == 0);
+    (void)leased_buffer_release_impl(lease);
+
+    python_tp_dealloc(self);
+}
+
+static int leased_buffer_traverse(PyObject *self, visitproc visit, void *arg) {
+    LeasedBuffer *lease = (LeasedBuffer *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(lease->pool);
+    return 0;
+}
+
+static int leased_buffer_clear(PyObject *self) {
+    LeasedBuffer *lease = (LeasedBuffer *)self;
+
+    Py_CLEAR(lease->pool);
+    return 0;
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-function-type"
+static PyMethodDef g_leased_buffer_methods[] = {
+    {"release", leased_buffer_release, METH_NOARGS, g_leased_buffer_release_doc},
+    {"__enter__", leased_buffer_enter, METH_NOARGS, NULL},
+    {"__exit__", (PyCFunction)leased_buffer_exit, METH_FASTCALL, NULL},
+    {NULL, NULL, 0, NULL},
+};
+#pragma GCC diagnostic pop
+
+// clang-format off
+static PyType_Slot g_leased_buffer_slots[] = {
+    {Py_tp_doc, (void *)g_leased_buffer_doc},
+    {Py_tp_dealloc, leased_buffer_dealloc},
+    {Py_tp_traverse, leased_buffer_traverse},
+    {Py_tp_clear, leased_buffer_clear},
+    {Py_tp_methods, g_leased_buffer_methods},
+    {Py_sq_length, leased_buffer_length},
+    {Py_bf_getbuffer, leased_buffer_getbuffer},
+    {Py_bf_releasebuffer, leased_buffer_releasebuffer},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_leased_buffer_spec = {
+    .name      = "_impl.LeasedBuffer",
+    .basicsize = sizeof(LeasedBuffer),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots     = g_leased_buffer_slots,
+};
+
+PyTypeObject *leased_buffer_register(PyObject *mod) {
+    PyTypeObject *tp = (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_leased_buffer_spec, NULL);
+    if (tp == NULL) {
+        return NULL;
+    }
+
+    if (PyModule_AddType(mod, tp) < 0) {
+        return NULL;
+    }
+
+    return tp;
+}
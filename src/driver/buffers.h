@@ -0,0 +1,117 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+#include <liburing.h>
+
+#include "driver/run_config.h"
+
+struct _ImplState;
+struct _BufferPool;
+
+typedef void (*BufferRecycleFn)(struct _BufferPool *self, int bid);
+
+/*
+ * Common header of all buffer pools. A pool owns a contiguous region
+ * of equally-sized buffers which are identified by their index.
+ */
+typedef struct _BufferPool {
+    PyObject_HEAD
+    BufferRecycleFn recycle;
+    char *memory;
+    unsigned int nentries;
+    unsigned int bufsize;
+} BufferPool;
+
+/*
+ * A ring of kernel-provided buffers for buffer-selecting operations.
+ *
+ * Operations submitted with IOSQE_BUFFER_SELECT don't reserve any
+ * memory upfront. The kernel picks a buffer from this ring only once
+ * data is actually available and reports its id in the completion.
+ */
+typedef struct {
+    BufferPool base;
+    struct io_uring *ring;
+    struct io_uring_buf_ring *br;
+    int bgid;
+} BufferRing;
+
+/*
+ * A pool of buffers registered with io_uring_register_buffers.
+ *
+ * The kernel pins the pages once at registration instead of on every
+ * operation. Python code leases slots explicitly and passes them to
+ * the *_fixed operations, which address them by index.
+ */
+typedef struct {
+    BufferPool base;
+    struct io_uring *ring;
+    int *freelist;
+    unsigned int nfree;
+} FixedBufferPool;
+
+/* A buffer from a BufferPool which is on loan to Python code. */
+typedef struct {
+    PyObject_HEAD
+    BufferPool *pool;
+    char *data;
+    Py_ssize_t len;
+    Py_ssize_t exports;
+    int bid;
+} LeasedBuffer;
+
+/*
+ * Allocates and registers a BufferRing on the given io_uring instance.
+ * Returns NULL with an exception set on failure.
+ */
+BufferRing *buffer_ring_create(struct _ImplState *state, struct io_uring *ring, RunConfig *config);
+
+/*
+ * Unregisters a BufferRing from its io_uring instance. Buffers which
+ * are still on loan stay valid, but will not be recycled anymore.
+ */
+void buffer_ring_detach(BufferRing *self);
+
+/*
+ * Allocates a FixedBufferPool and registers its memory on the given
+ * io_uring instance. Returns NULL with an exception set on failure.
+ */
+FixedBufferPool *fixed_buffer_pool_create(struct _ImplState *state, struct io_uring *ring, RunConfig *config);
+
+/*
+ * Unregisters a FixedBufferPool from its io_uring instance. Buffers
+ * which are still on loan stay valid, but will not be reused anymore.
+ */
+void fixed_buffer_pool_detach(FixedBufferPool *self);
+
+/*
+ * Leases a free slot of the pool out to Python code. Fails with
+ * ENOBUFS when all slots are on loan.
+ */
+LeasedBuffer *fixed_buffer_pool_acquire(FixedBufferPool *self);
+
+/*
+ * Validates that ob is a live lease from a FixedBufferPool which can
+ * hold nbytes, and pins it until fixed_buffer_unpin is called. Pinned
+ * buffers can't be released, so the kernel never sees a reused slot.
+ */
+LeasedBuffer *fixed_buffer_pin(struct _ImplState *state, PyObject *ob, unsigned int nbytes);
+void fixed_buffer_unpin(LeasedBuffer *self);
+
+/* Leases a free slot from the current runtime's FixedBufferPool. */
+PyObject *fixed_buffer_lease(PyObject *mod, PyObject *args);
+
+/* Leases the buffer with the given id and length out to Python code. */
+LeasedBuffer *buffer_pool_lease(BufferPool *self, int bid, Py_ssize_t len);
+
+static inline LeasedBuffer *buffer_ring_lease(BufferRing *self, int bid, Py_ssize_t len) {
+    return buffer_pool_lease(&self->base, bid, len);
+}
+
+PyTypeObject *buffer_ring_register(PyObject *mod);
+PyTypeObject *fixed_buffer_pool_register(PyObject *mod);
+PyTypeObject *leased_buffer_register(PyObject *mod);
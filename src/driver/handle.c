@@ -5,9 +5,73 @@
 
 #include <assert.h>
 
+#include "op/chain.h"
+#include "op/relay.h"
+#include "op/sendfile.h"
+#include "op/sleep.h"
+
+static inline uint64_t runtime_clock_ms(void) {
+    return timer_clock_ns() / 1000000;
+}
+
 static inline void runtime_destroy(RuntimeHandle *handle);
 
-static inline RuntimeHandle *runtime_create(RunConfig *config) {
+static void runtime_layout_init(RuntimeLayout *self, RunConfig *config) {
+    self->sq_size     = config->sq_size;
+    self->cq_size     = config->cq_size;
+    self->ftable_size = config->ftable_size;
+    self->pbuf_count  = config->pbuf_count;
+    self->pbuf_size   = config->pbuf_size;
+    self->fbuf_count  = config->fbuf_count;
+    self->fbuf_size   = config->fbuf_size;
+    self->wqfd        = config->wqfd;
+}
+
+static bool runtime_layout_matches(RuntimeLayout *self, RunConfig *config) {
+    RuntimeLayout other;
+    runtime_layout_init(&other, config);
+
+    return self->sq_size == other.sq_size && self->cq_size == other.cq_size &&
+           self->ftable_size == other.ftable_size && self->pbuf_count == other.pbuf_count &&
+           self->pbuf_size == other.pbuf_size && self->fbuf_count == other.fbuf_count &&
+           self->fbuf_size == other.fbuf_size && self->wqfd == other.wqfd;
+}
+
+/* Whether a runtime for config should be kept for the next run. */
+static inline bool runtime_wants_persistence(RunConfig *config) {
+    /* Workers of the multi-threaded flavor only live for a single run. */
+    return config->persistent && config->workers == 1;
+}
+
+/* Applies the per-run settings of config to a new or reused runtime. */
+static void runtime_begin(RuntimeHandle *handle, RunConfig *config) {
+    handle->lifo_streak     = 0;
+    handle->step_budget     = config->step_budget;
+    handle->task_budget     = config->task_budget;
+    handle->coop_remaining  = config->task_budget;
+    handle->worker          = NULL;
+    handle->channel_waiters = 0;
+    handle->active          = true;
+}
+
+/* Drops the tasks and timers which the last run left behind. */
+static void runtime_drop_tasks(RuntimeHandle *handle) {
+    TimerEntry *entry;
+
+    task_list_clear(&handle->run_queue);
+    Py_CLEAR(handle->lifo_slot);
+
+    /* Drop the sleeps which never expired along with their tasks. */
+    while ((entry = timer_wheel_pop_any(&handle->timers)) != NULL) {
+        SleepOperation *op = sleep_operation_from_entry(entry);
+
+        op->base.inflight = false;
+        Py_CLEAR(op->base.awaiter);
+        Py_DECREF(op);
+    }
+}
+
+static inline RuntimeHandle *runtime_create(ImplState *state, RunConfig *config) {
     RuntimeHandle *handle = PyMem_Malloc(sizeof(RuntimeHandle));
     if (handle == NULL) {
         PyErr_SetNone(PyExc_MemoryError);
@@ -19,6 +83,31 @@ static inline RuntimeHandle *runtime_create(RunConfig *config) {
         return NULL;
     }
     task_list_init(&handle->run_queue);
+    handle->lifo_slot = NULL;
+    timer_wheel_init(&handle->timers, runtime_clock_ms());
+    pipe_pool_init(&handle->pipes);
+    runtime_begin(handle, config);
+    handle->persistent    = runtime_wants_persistence(config);
+    handle->buffers       = NULL;
+    handle->fixed_buffers = NULL;
+    runtime_layout_init(&handle->layout, config);
+
+    /* Register buffers while the ring is still disabled. */
+    if (config->pbuf_count > 0) {
+        handle->buffers = buffer_ring_create(state, &handle->proactor.ring, config);
+        if (handle->buffers == NULL) {
+            runtime_destroy(handle);
+            return NULL;
+        }
+    }
+
+    if (config->fbuf_count > 0) {
+        handle->fixed_buffers = fixed_buffer_pool_create(state, &handle->proactor.ring, config);
+        if (handle->fixed_buffers == NULL) {
+            runtime_destroy(handle);
+            return NULL;
+        }
+    }
 
     if (proactor_enable(&handle->proactor) != 0) {
         runtime_destroy(handle);
@@ -29,9 +118,27 @@ static inline RuntimeHandle *runtime_create(RunConfig *config) {
 }
 
 static inline void runtime_destroy(RuntimeHandle *handle) {
-    task_list_clear(&handle->run_queue);
+    runtime_drop_tasks(handle);
+
+    /*
+     * Buffers that are still on loan keep the pool memory alive, but
+     * the ring itself must be gone before the io_uring is torn down.
+     */
+    if (handle->buffers != NULL) {
+        buffer_ring_detach(handle->buffers);
+        Py_CLEAR(handle->buffers);
+    }
+
+    if (handle->fixed_buffers != NULL) {
+        fixed_buffer_pool_detach(handle->fixed_buffers);
+        Py_CLEAR(handle->fixed_buffers);
+    }
+
     proactor_exit(&handle->proactor);
 
+    /* Cancelled transfers have returned their pipes by now. */
+    pipe_pool_clear(&handle->pipes);
+
     PyMem_Free(handle);
 }
 
@@ -41,12 +148,26 @@ RuntimeHandle *runtime_enter(ImplState *state, RunConfig *config) {
     assert(PyThread_tss_is_created(state->local_handle));
 
     handle = PyThread_tss_get(state->local_handle);
-    if (handle != NULL) {
+    if (handle != NULL && handle->active) {
         PyErr_SetString(PyExc_RuntimeError, "Runtime is already active on the current thread");
         return NULL;
     }
 
-    handle = runtime_create(config);
+    /*
+     * An idle runtime from an earlier run is reused as is when the ring
+     * would come out the same. Otherwise it makes room for a new one.
+     */
+    if (handle != NULL) {
+        if (runtime_wants_persistence(config) && runtime_layout_matches(&handle->layout, config)) {
+            runtime_begin(handle, config);
+            return handle;
+        }
+
+        PyThread_tss_set(state->local_handle, NULL);
+        runtime_destroy(handle);
+    }
+
+    handle = runtime_create(state, config);
     if (handle == NULL) {
         return NULL;
     }
@@ -57,17 +178,48 @@ RuntimeHandle *runtime_enter(ImplState *state, RunConfig *config) {
 
 void runtime_exit(ImplState *state) {
     RuntimeHandle *handle = PyThread_tss_get(state->local_handle);
-    if (handle == NULL) {
+    if (handle == NULL || !handle->active) {
         return;
     }
 
+    /*
+     * Keep a persistent runtime around once it is back to a clean slate.
+     * A ring that fails to reset is not worth keeping either way.
+     */
+    handle->active = false;
+    if (handle->persistent) {
+        runtime_drop_tasks(handle);
+        if (proactor_reset(&handle->proactor, handle->layout.ftable_size)) {
+            timer_wheel_init(&handle->timers, runtime_clock_ms());
+            return;
+        }
+    }
+
     runtime_destroy(handle);
     PyThread_tss_set(state->local_handle, NULL);
 }
 
-RuntimeHandle *runtime_get_local(ImplState *state) {
+PyObject *runtime_shutdown(PyObject *mod, PyObject *Py_UNUSED(args)) {
+    ImplState *state = PyModule_GetState(mod);
+
     RuntimeHandle *handle = PyThread_tss_get(state->local_handle);
     if (handle == NULL) {
+        Py_RETURN_NONE;
+    }
+
+    if (handle->active) {
+        PyErr_SetString(PyExc_RuntimeError, "Cannot shut down the runtime from within run()");
+        return NULL;
+    }
+
+    PyThread_tss_set(state->local_handle, NULL);
+    runtime_destroy(handle);
+    Py_RETURN_NONE;
+}
+
+RuntimeHandle *runtime_get_local(ImplState *state) {
+    RuntimeHandle *handle = PyThread_tss_get(state->local_handle);
+    if (handle == NULL || !handle->active) {
         PyErr_SetString(PyExc_RuntimeError, "No runtime active on the current thread");
         return NULL;
     }
@@ -75,22 +227,167 @@ RuntimeHandle *runtime_get_local(ImplState *state) {
     return handle;
 }
 
+static void runtime_schedule_timer(RuntimeHandle *rt, Task *task, SleepOperation *op) {
+    op->base.awaiter = (Task *)Py_NewRef((PyObject *)task);
+
+    /*
+     * The wheel holds the reference to op until the timer expires.
+     * A deadline that already passed wakes the task up right away,
+     * which makes a zero-length sleep yield to the other tasks.
+     */
+    if (timer_wheel_insert(&rt->timers, &op->entry)) {
+        op->base.inflight = true;
+        return;
+    }
+
+    outcome_store_result(&op->base.outcome, Py_NewRef(Py_None));
+    operation_wake(&rt->run_queue, &op->base);
+    Py_DECREF(op);
+}
+
 int runtime_schedule_io(RuntimeHandle *rt, Task *task, Operation *op) {
-    struct io_uring_sqe *sqe;
+    /*
+     * The completions of a multishot operation all arrive on the ring
+     * it was submitted to, so its task must not move to another worker.
+     */
+    if (rt->worker != NULL && PyObject_TypeCheck(op, op->module_state->MultishotOperation_type) != 0) {
+        task->home = rt->worker;
+    }
+
+    /*
+     * A multishot operation may still be armed in the kernel from an
+     * earlier submission. In that case, the task just waits for the
+     * next completion and the proactor already holds a reference.
+     */
+    if (op->inflight) {
+        op->awaiter = (Task *)Py_NewRef((PyObject *)task);
+        Py_DECREF(op);
+        return 0;
+    }
+
+    /* Sleeps are handled by the timer wheel without the kernel. */
+    if (Py_IS_TYPE(op, op->module_state->SleepOperation_type)) {
+        runtime_schedule_timer(rt, task, (SleepOperation *)op);
+        return 0;
+    }
+
+    /* Chains need several linked submission entries at once. */
+    if (Py_IS_TYPE(op, op->module_state->ChainOperation_type)) {
+        if (chain_operation_submit((ChainOperation *)op, &rt->proactor) != 0) {
+            return -1;
+        }
+
+        op->awaiter = (Task *)Py_NewRef((PyObject *)task);
+        return 0;
+    }
+
+    /* Relays keep queueing submissions until both directions are done. */
+    if (Py_IS_TYPE(op, op->module_state->RelayOperation_type)) {
+        if (relay_operation_submit((RelayOperation *)op, &rt->proactor) != 0) {
+            return -1;
+        }
+
+        op->awaiter = (Task *)Py_NewRef((PyObject *)task);
+        return 0;
+    }
+
+    if (Py_IS_TYPE(op, op->module_state->SendfileOperation_type)) {
+        if (sendfile_operation_submit((SendfileOperation *)op, &rt->proactor, &rt->pipes) != 0) {
+            return -1;
+        }
+
+        op->awaiter = (Task *)Py_NewRef((PyObject *)task);
+        return 0;
+    }
+
+    unsigned nentries = proactor_operation_size(op);
+    if (nentries > 1 && !proactor_reserve(&rt->proactor, nentries)) {
+        return -1;
+    }
+
+    if (proactor_push_operation(&rt->proactor, op, 0) != 0) {
+        return -1;
+    }
+
+    op->awaiter = (Task *)Py_NewRef((PyObject *)task);
+    return 0;
+}
 
-    sqe = proactor_get_submission(&rt->proactor);
-    if (sqe == NULL) {
+long long runtime_next_timeout(RuntimeHandle *rt) {
+    uint64_t when = timer_wheel_next_expiration(&rt->timers);
+    if (when == UINT64_MAX) {
         return -1;
     }
 
+    uint64_t now = runtime_clock_ms();
+    return when > now ? (long long)(when - now) : 0;
+}
+
+void runtime_wake(RuntimeHandle *rt, TaskList *woken) {
+    if (task_list_empty(woken)) {
+        return;
+    }
+
+    /* The reference moves from the list into the slot. */
+    Task *last = task_list_pop_back(woken);
+    task_list_append(&rt->run_queue, woken);
+
+    if (rt->lifo_slot != NULL) {
+        task_list_push_back(&rt->run_queue, rt->lifo_slot);
+        Py_DECREF(rt->lifo_slot);
+    }
+    rt->lifo_slot = last;
+}
+
+void runtime_drain_lifo(RuntimeHandle *rt, TaskList *ready) {
+    Task *task = rt->lifo_slot;
+    if (task == NULL) {
+        rt->lifo_streak = 0;
+        return;
+    }
+
     /*
-     * Associate the kernel submission with the corresponding Operation.
-     * This allows us to retrieve the Operation (and its awaiter) back
-     * when the completion for this operation arrives.
+     * Two tasks which keep waking each other would otherwise hold on
+     * to the slot forever and starve the rest of the queue whenever
+     * the step budget cuts a step short.
      */
-    op->awaiter = (Task *)Py_NewRef((PyObject *)task);
-    (op->vtable->prepare)((PyObject *)op, sqe);
-    io_uring_sqe_set_data(sqe, op);
+    if (rt->lifo_streak < RUNTIME_LIFO_CAP) {
+        task_list_push_front(ready, task);
+        ++rt->lifo_streak;
+    } else {
+        task_list_push_back(ready, task);
+        rt->lifo_streak = 0;
+    }
 
-    return 0;
+    rt->lifo_slot = NULL;
+    Py_DECREF(task);
+}
+
+void runtime_fire_timers(RuntimeHandle *rt) {
+    uint64_t now = runtime_clock_ms();
+    TimerEntry *entry;
+
+    while ((entry = timer_wheel_poll(&rt->timers, now)) != NULL) {
+        SleepOperation *op = sleep_operation_from_entry(entry);
+
+        outcome_store_result(&op->base.outcome, Py_NewRef(Py_None));
+        operation_wake(&rt->run_queue, &op->base);
+
+        op->base.inflight = false;
+        Py_DECREF(op);
+    }
+}
+
+bool runtime_coop_consume(ImplState *state) {
+    RuntimeHandle *rt = PyThread_tss_get(state->local_handle);
+    if (rt == NULL || rt->task_budget == 0) {
+        return true;
+    }
+
+    if (rt->coop_remaining == 0) {
+        return false;
+    }
+
+    --rt->coop_remaining;
+    return true;
 }
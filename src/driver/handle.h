@@ -1,23 +1,107 @@
 /* This source file is part of the boros project. */
 /* SPDX-License-Identifier: ISC */
 
+#pragma once
+
 #include "util/python.h"
 
+#include "driver/buffers.h"
+#include "driver/pipes.h"
 #include "driver/proactor.h"
 #include "driver/run_config.h"
+#include "driver/timer.h"
 #include "module.h"
 #include "op/base.h"
 #include "task.h"
 
+/*
+ * How many loop steps in a row may start with the task from the LIFO
+ * slot before it has to queue up behind the others like everyone else.
+ */
+#define RUNTIME_LIFO_CAP 3
+
+/* The settings of a RunConfig which shape the ring and its registrations. */
+typedef struct {
+    unsigned int sq_size;
+    unsigned int cq_size;
+    unsigned int ftable_size;
+    unsigned int pbuf_count;
+    unsigned int pbuf_size;
+    unsigned int fbuf_count;
+    unsigned int fbuf_size;
+    int wqfd;
+} RuntimeLayout;
+
 /* Per-thread runtime context. */
 typedef struct {
     Proactor proactor;
     TaskList run_queue;
+    /* The task woken last by a completion, which runs first next step. */
+    Task *lifo_slot;
+    unsigned lifo_streak;
+    BufferRing *buffers;
+    FixedBufferPool *fixed_buffers;
+    TimerWheel timers;
+    PipePool pipes;
+    /* Task resumes per loop step before the ring is serviced again. */
+    unsigned step_budget;
+    /* Awaits a task may complete without suspending, and what is left of it. */
+    unsigned task_budget;
+    unsigned coop_remaining;
+    /* The worker of the multi-threaded flavor that owns this runtime, if any. */
+    struct _Worker *worker;
+    /* Tasks parked on channels of this runtime, waiting for a message. */
+    size_t channel_waiters;
+    /*
+     * A persistent runtime stays with its thread between runs, idle
+     * while no run is active, and is reused by the next run whose
+     * config has the same layout.
+     */
+    bool persistent;
+    bool active;
+    RuntimeLayout layout;
 } RuntimeHandle;
 
 RuntimeHandle *runtime_enter(ImplState *state, RunConfig *config);
 void runtime_exit(ImplState *state);
 
+/* Destroys the idle persistent runtime of the current thread, if any. */
+PyObject *runtime_shutdown(PyObject *mod, PyObject *args);
+
 RuntimeHandle *runtime_get_local(ImplState *state);
 
+/*
+ * Suspends task until op completes, submitting op to the kernel if it
+ * is not in flight already. Takes over the reference to op on success.
+ */
 int runtime_schedule_io(RuntimeHandle *rt, Task *task, Operation *op);
+
+/*
+ * Returns the number of milliseconds until the nearest timer expires,
+ * 0 if one already did, or -1 if there are no timers at all.
+ */
+long long runtime_next_timeout(RuntimeHandle *rt);
+
+/*
+ * Queues the tasks in woken, which were woken by completions in this
+ * order. The last one takes the LIFO slot while its data is still hot
+ * in the caches, the one it displaces goes to the back of the queue.
+ */
+void runtime_wake(RuntimeHandle *rt, TaskList *woken);
+
+/*
+ * Moves the task in the LIFO slot into ready for the upcoming loop step.
+ * It goes first unless it did so for RUNTIME_LIFO_CAP steps in a row.
+ */
+void runtime_drain_lifo(RuntimeHandle *rt, TaskList *ready);
+
+/* Wakes the tasks of all timers that expired by now. */
+void runtime_fire_timers(RuntimeHandle *rt);
+
+/*
+ * Charges the running task for an await that completes without going
+ * through the event loop. Returns false when the task used up its
+ * budget, in which case the awaitable should yield None to reschedule
+ * the task before handing out its result.
+ */
+bool runtime_coop_consume(ImplState *state);
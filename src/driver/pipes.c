@@ -0,0 +1,49 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "driver/pipes.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+void pipe_pool_init(PipePool *self) {
+    self->count = 0;
+}
+
+void pipe_pool_clear(PipePool *self) {
+    while (self->count > 0) {
+        --self->count;
+        close(self->fds[self->count][0]);
+        close(self->fds[self->count][1]);
+    }
+}
+
+bool pipe_pool_acquire(PipePool *self, int fds[2]) {
+    if (self->count > 0) {
+        --self->count;
+        fds[0] = self->fds[self->count][0];
+        fds[1] = self->fds[self->count][1];
+        return true;
+    }
+
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return false;
+    }
+
+    return true;
+}
+
+void pipe_pool_release(PipePool *self, int fds[2], bool empty) {
+    if (empty && self->count < PIPE_POOL_CAPACITY) {
+        self->fds[self->count][0] = fds[0];
+        self->fds[self->count][1] = fds[1];
+        ++self->count;
+    } else {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    fds[0] = -1;
+    fds[1] = -1;
+}
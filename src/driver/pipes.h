@@ -0,0 +1,36 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+/* Number of idle pipes a runtime keeps around for reuse. */
+#define PIPE_POOL_CAPACITY 16
+
+/*
+ * A cache of empty pipes for operations that splice through one. This
+ * saves two system calls for creating and closing a pipe per transfer.
+ */
+typedef struct {
+    int fds[PIPE_POOL_CAPACITY][2];
+    size_t count;
+} PipePool;
+
+/* Initializes an empty pool. */
+void pipe_pool_init(PipePool *self);
+
+/* Closes all pipes in the pool. */
+void pipe_pool_clear(PipePool *self);
+
+/*
+ * Hands out the read and write end of an idle pipe, or creates a new
+ * one. Raises an OSError when that fails.
+ */
+bool pipe_pool_acquire(PipePool *self, int fds[2]);
+
+/*
+ * Returns a pipe to the pool. Pipes which may still hold data are never
+ * reused, since the next transfer would send it along with its own.
+ */
+void pipe_pool_release(PipePool *self, int fds[2], bool empty);
@@ -5,32 +5,176 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <poll.h>
 #include <string.h>
 
+#include "channel.h"
 #include "op/base.h"
+#include "op/chain.h"
+
+static uint64_t g_next_generation = 1;
+
+static inline Operation *untag_operation(uint64_t data) {
+    return (Operation *)(uintptr_t)(data & ~(uint64_t)PROACTOR_TAG_MASK);
+}
+
+static void reap_link_timeout(Proactor *proactor, TaskList *list, Operation *op, int res);
+static void reap_leg(Proactor *proactor, TaskList *list, Operation *op, struct io_uring_cqe *cqe);
+
+static void reap_completion(Proactor *proactor, TaskList *list, struct io_uring_cqe *cqe) {
+    struct io_uring_cqe tmp;
 
-static inline void reap_completion(TaskList *list, struct io_uring_cqe *cqe) {
     assert(cqe != NULL);
 
     /*
      * Extract the Operation from the completion entry and run its
      * finalizer to make the result available to the Python side.
+     * Internal submissions of the proactor carry no Operation.
      */
-    Operation *op = (Operation *)io_uring_cqe_get_data(cqe);
+    uint64_t data = io_uring_cqe_get_data64(cqe);
+    if (data == 0) {
+        --proactor->pending_events;
+        return;
+    }
+
+    if ((data & PROACTOR_MESSAGE) != 0) {
+        Channel *channel = (Channel *)(uintptr_t)(data & ~PROACTOR_MESSAGE);
+
+        /* Drop the reference the sender took for the message. */
+        channel_deliver(channel, proactor, list, cqe->res);
+        Py_DECREF(channel);
+        return;
+    }
+
+    if (data == PROACTOR_WAKEUP) {
+        /* The poll has to be armed again once it stopped for any reason. */
+        if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
+            proactor->wakeup_armed = false;
+        }
+        return;
+    }
+
+    unsigned tag = data & PROACTOR_TAG_MASK;
+    if (tag == PROACTOR_TAG_LINK_TIMEOUT) {
+        reap_link_timeout(proactor, list, untag_operation(data), cqe->res);
+        return;
+    }
+
+    if (tag >= PROACTOR_TAG_LEG) {
+        reap_leg(proactor, list, untag_operation(data), cqe);
+        return;
+    }
+
+    Operation *op = (Operation *)(uintptr_t)data;
+
+    /*
+     * Zero-copy sends post a notification once the kernel let go of the
+     * buffer. It carries no result, so it must neither be mistaken for
+     * the cancellation by a timeout nor wake the task a second time.
+     */
+    bool notification = (cqe->flags & IORING_CQE_F_NOTIF) != 0;
+
+    /*
+     * An operation cancelled by its linked timeout completes with
+     * ECANCELED, which we report as ETIMEDOUT instead. Whether the
+     * timeout fired is only known once its own completion arrived.
+     */
+    if (op->timeout_state != Timeout_None && !notification) {
+        if (cqe->res == -ECANCELED) {
+            if (op->timeout_state == Timeout_Armed) {
+                /* Keep the flags, IORING_CQE_F_MORE may still be set. */
+                op->timeout_state  = Timeout_Deferred;
+                op->deferred_flags = cqe->flags;
+                return;
+            }
+
+            tmp     = *cqe;
+            tmp.res = -ETIMEDOUT;
+            cqe     = &tmp;
+        }
+
+        op->timeout_state = Timeout_None;
+    }
+
     (op->vtable->complete)((PyObject *)op, cqe);
-    op->state = State_Ready;
 
-    /* Append the unblocked task to the end of the run queue. */
-    task_list_push_back(list, op->awaiter);
+    if (notification) {
+        /* The result was delivered already, or is still deferred. */
+    } else if (op->parent != NULL) {
+        /*
+         * Linked operations have no awaiter of their own. Their chain
+         * wakes up once the last link completed, and then gives up
+         * the reference the proactor held for it.
+         */
+        ChainOperation *chain = (ChainOperation *)op->parent;
+
+        op->parent = NULL;
+        op->state  = State_Ready;
+        if (chain_operation_finish_link(chain)) {
+            operation_wake(list, &chain->base);
+            Py_DECREF(chain);
+        }
+    } else {
+        operation_wake(list, op);
+    }
+
+    /*
+     * Multishot operations post several completions for a single
+     * submission. As long as IORING_CQE_F_MORE is set, the kernel
+     * still holds on to the submission and more are to come.
+     */
+    if ((cqe->flags & IORING_CQE_F_MORE) != 0) {
+        return;
+    }
 
     /*
      * The proactor holds a reference on Operation for the duration
      * of its trip through the kernel to ensure it stays alive while
      * still in use. Now we don't need it anymore.
      */
+    op->inflight = false;
+    --proactor->pending_events;
     Py_DECREF(op);
 }
 
+static void reap_link_timeout(Proactor *proactor, TaskList *list, Operation *op, int res) {
+    bool fired = res == -ETIME;
+
+    --proactor->pending_events;
+
+    if (op->timeout_state == Timeout_Deferred) {
+        /* The operation completed first, so finish it now that we know why. */
+        struct io_uring_cqe tmp = {
+            .user_data = (uint64_t)(uintptr_t)op,
+            .res       = fired ? -ETIMEDOUT : -ECANCELED,
+            .flags     = op->deferred_flags,
+        };
+
+        op->timeout_state = Timeout_None;
+        reap_completion(proactor, list, &tmp);
+    } else if (op->timeout_state == Timeout_Armed) {
+        op->timeout_state = fired ? Timeout_Fired : Timeout_None;
+    }
+
+    /* Drop the reference that kept op alive for the linked timeout. */
+    Py_DECREF(op);
+}
+
+static void reap_leg(Proactor *proactor, TaskList *list, Operation *op, struct io_uring_cqe *cqe) {
+    --proactor->pending_events;
+
+    /*
+     * The operation may queue further submissions from its completion
+     * handler. The proactor holds a single reference for all of them,
+     * which it gives up once the operation reports it is done.
+     */
+    (op->vtable->complete)((PyObject *)op, cqe);
+    if (!op->inflight) {
+        operation_wake(list, op);
+        Py_DECREF(op);
+    }
+}
+
 static inline void reap_completions(Proactor *proactor, TaskList *list) {
     unsigned int count = 0;
     unsigned head;
@@ -38,11 +182,55 @@ static inline void reap_completions(Proactor *proactor, TaskList *list) {
 
     io_uring_for_each_cqe(&proactor->ring, head, cqe) {
         ++count;
-        reap_completion(list, cqe);
+        reap_completion(proactor, list, cqe);
     }
 
     io_uring_cq_advance(&proactor->ring, count);
-    proactor->pending_events -= count;
+}
+
+static void proactor_cancel_all(Proactor *proactor) {
+    TaskList woken;
+    struct io_uring_sqe *sqe;
+
+    task_list_init(&woken);
+
+    /*
+     * Completions run Python code, so preserve the exception that
+     * may have caused the runtime to shut down in the first place.
+     */
+    PyObject *exc = PyErr_GetRaisedException();
+
+    /* Operations must not queue follow-up work past this point. */
+    proactor->closing = true;
+
+    sqe = io_uring_get_sqe(&proactor->ring);
+    if (sqe == NULL) {
+        (void)io_uring_submit(&proactor->ring);
+        sqe = io_uring_get_sqe(&proactor->ring);
+    }
+
+    if (sqe != NULL) {
+        io_uring_prep_cancel64(sqe, 0, IORING_ASYNC_CANCEL_ANY);
+        io_uring_sqe_set_data(sqe, NULL);
+        ++proactor->pending_events;
+    }
+
+    while (proactor->pending_events > 0) {
+        int res = io_uring_submit_and_wait(&proactor->ring, 1);
+        if (res < 0 && res != -EINTR) {
+            break;
+        }
+
+        reap_completions(proactor, &woken);
+    }
+
+    /* Nobody is left to resume the tasks we woke up. */
+    task_list_clear(&woken);
+    if (PyErr_Occurred()) {
+        PyErr_WriteUnraisable(NULL);
+    }
+
+    PyErr_SetRaisedException(exc);
 }
 
 int proactor_init(Proactor *proactor, RunConfig *config) {
@@ -123,12 +311,69 @@ int proactor_init(Proactor *proactor, RunConfig *config) {
     }
 
     proactor->pending_events = 0;
+    proactor->closing        = false;
+    proactor->wakeup_fd      = -1;
+    proactor->wakeup_armed   = false;
+    proactor->generation     = __atomic_fetch_add(&g_next_generation, 1, __ATOMIC_RELAXED);
     return 0;
 }
 
+static void proactor_quiesce(Proactor *proactor) {
+    /*
+     * Operations may still be in flight when the runtime shuts down,
+     * e.g. multishot operations which were not iterated until the end.
+     * Cancel them and let the kernel release all resources it uses.
+     */
+    if (proactor->pending_events > 0) {
+        proactor_cancel_all(proactor);
+    }
+
+    /*
+     * Messages that arrived last still hold references to their channel.
+     * Flush the deferred task work which may be posting some of them.
+     */
+    (void)io_uring_get_events(&proactor->ring);
+    if (io_uring_cq_ready(&proactor->ring) > 0) {
+        TaskList woken;
+        task_list_init(&woken);
+
+        PyObject *exc = PyErr_GetRaisedException();
+        reap_completions(proactor, &woken);
+        task_list_clear(&woken);
+        PyErr_SetRaisedException(exc);
+    }
+
+    assert(proactor->pending_events == 0);
+}
+
 void proactor_exit(Proactor *proactor) {
+    proactor_quiesce(proactor);
     io_uring_queue_exit(&proactor->ring);
-    assert(proactor->pending_events == 0);
+}
+
+bool proactor_reset(Proactor *proactor, unsigned int ftable_size) {
+    proactor_quiesce(proactor);
+
+    /*
+     * Replacing the table closes the direct descriptors which the last
+     * run left open, at the cost of two system calls. That is still far
+     * cheaper than setting up a new ring and keeps slot allocation from
+     * running dry over many runs.
+     */
+    if (ftable_size > 0) {
+        if (io_uring_unregister_files(&proactor->ring) < 0) {
+            return false;
+        }
+
+        if (io_uring_register_files_sparse(&proactor->ring, ftable_size) < 0) {
+            return false;
+        }
+    }
+
+    /* Channels created by the last run must not receive anything now. */
+    proactor->closing    = false;
+    proactor->generation = __atomic_fetch_add(&g_next_generation, 1, __ATOMIC_RELAXED);
+    return true;
 }
 
 int proactor_enable(Proactor *proactor) {
@@ -168,6 +413,72 @@ struct io_uring_sqe *proactor_get_submission(Proactor *proactor) {
     return sqe;
 }
 
+bool proactor_reserve(Proactor *proactor, unsigned nentries) {
+    if (proactor_can_submit(proactor, nentries)) {
+        return true;
+    }
+
+    if (nentries > proactor->ring.sq.ring_entries) {
+        PyErr_SetString(PyExc_ValueError, "Linked submissions are longer than the submission queue");
+        return false;
+    }
+
+    return proactor_submit(proactor) >= 0;
+}
+
+int proactor_push_operation(Proactor *proactor, Operation *op, unsigned char flags) {
+    struct io_uring_sqe *sqe;
+
+    sqe = proactor_get_submission(proactor);
+    if (sqe == NULL) {
+        return -1;
+    }
+
+    /*
+     * Associate the kernel submission with the corresponding Operation.
+     * This allows us to retrieve the Operation (and its awaiter) back
+     * when the completion for this operation arrives.
+     */
+    (op->vtable->prepare)((PyObject *)op, sqe);
+    sqe->flags |= op->sqe_flags | flags;
+    io_uring_sqe_set_data(sqe, op);
+    op->inflight = true;
+
+    if (op->timeout_state == Timeout_Pending) {
+        /* A linked timeout must directly follow the entry it applies to. */
+        sqe->flags |= IOSQE_IO_LINK;
+
+        sqe = proactor_get_submission(proactor);
+        assert(sqe != NULL);
+
+        io_uring_prep_link_timeout(sqe, &op->timeout, 0);
+        sqe->flags |= flags;
+        io_uring_sqe_set_data64(sqe, proactor_tag(op, PROACTOR_TAG_LINK_TIMEOUT));
+
+        op->timeout_state = Timeout_Armed;
+        Py_INCREF(op);
+    }
+
+    return 0;
+}
+
+static void proactor_arm_wakeup(Proactor *proactor) {
+    /* With a full queue, the next call to proactor_run tries again. */
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&proactor->ring);
+    if (sqe == NULL) {
+        return;
+    }
+
+    io_uring_prep_poll_multishot(sqe, proactor->wakeup_fd, POLLIN);
+    io_uring_sqe_set_data64(sqe, PROACTOR_WAKEUP);
+    proactor->wakeup_armed = true;
+}
+
+void proactor_set_wakeup(Proactor *proactor, int fd) {
+    proactor->wakeup_fd = fd;
+    proactor_arm_wakeup(proactor);
+}
+
 bool proactor_can_submit(Proactor *proactor, unsigned nentries) {
     return io_uring_sq_space_left(&proactor->ring) >= nentries;
 }
@@ -195,19 +506,62 @@ int proactor_submit(Proactor *proactor) {
     }
 }
 
-int proactor_run(Proactor *proactor, TaskList *list, unsigned long timeout) {
+static int proactor_wait(Proactor *proactor, struct __kernel_timespec *ts) {
+    struct io_uring_cqe *tmp;
     int res;
 
-    if (timeout == 0) {
+    /*
+     * Completions that are already there make the wait return right
+     * away, so it isn't worth handing the GIL to another thread only to
+     * queue up for it again.
+     */
+    if (io_uring_cq_ready(&proactor->ring) > 0) {
+        return io_uring_submit(&proactor->ring);
+    }
+
+    /*
+     * Waiting with the GIL held starves every other thread in the process
+     * for as long as the ring is idle, and without a GIL, an attached
+     * thread state stalls them at the next stop-the-world pause instead.
+     *
+     * Nothing in here touches Python objects, and the ring stays owned by
+     * this thread: other threads can't reach it through the runtime, and
+     * memory referenced by in-flight submissions is kept alive by their
+     * operations regardless of who holds the GIL.
+     */
+    Py_BEGIN_ALLOW_THREADS
+    if (ts == NULL) {
         res = io_uring_submit_and_wait(&proactor->ring, 1);
     } else {
-        struct io_uring_cqe *tmp;
+        res = io_uring_submit_and_wait_timeout(&proactor->ring, &tmp, 1, ts, NULL);
+    }
+    Py_END_ALLOW_THREADS
+
+    return res;
+}
+
+int proactor_run(Proactor *proactor, TaskList *list, long long timeout_ms) {
+    int res;
+
+    if (proactor->wakeup_fd >= 0 && !proactor->wakeup_armed) {
+        proactor_arm_wakeup(proactor);
+    }
+
+    if (timeout_ms < 0) {
+        res = proactor_wait(proactor, NULL);
+    } else if (timeout_ms == 0) {
+        /*
+         * With IORING_SETUP_DEFER_TASKRUN, completions are only posted
+         * when we enter the kernel asking for them, even for a poll.
+         */
+        res = io_uring_submit_and_get_events(&proactor->ring);
+    } else {
         struct __kernel_timespec ts = {
-            .tv_sec  = timeout / 1000,
-            .tv_nsec = (timeout % 1000) * 1000000,
+            .tv_sec  = timeout_ms / 1000,
+            .tv_nsec = (timeout_ms % 1000) * 1000000,
         };
 
-        res = io_uring_submit_and_wait_timeout(&proactor->ring, &tmp, 1, &ts, NULL);
+        res = proactor_wait(proactor, &ts);
     }
 
     if (res < 0) {
@@ -8,19 +8,92 @@
 #include <liburing.h>
 
 #include "driver/run_config.h"
+#include "op/base.h"
 #include "task.h"
 
 typedef struct {
     struct io_uring ring;
     size_t pending_events;
+    /* Set while in-flight operations are cancelled for shutdown. */
+    bool closing;
+    /* A descriptor polled for readability to interrupt waits, or -1. */
+    int wakeup_fd;
+    bool wakeup_armed;
+    /* Unique per ring, unlike the address of a Proactor or its descriptor. */
+    uint64_t generation;
 } Proactor;
 
+/*
+ * Submissions carry the address of their Operation with a tag in the
+ * lowest three bits, which are never set for Python objects. Untagged
+ * entries belong to the operation itself and tag 1 marks its linked
+ * timeout. Tags from PROACTOR_TAG_LEG upwards are free for operations
+ * which drive several submissions on their own. Their completions are
+ * all passed to the complete hook, and the operation finishes once it
+ * clears its inflight flag.
+ */
+#define PROACTOR_TAG_MASK         7
+#define PROACTOR_TAG_LINK_TIMEOUT 1
+#define PROACTOR_TAG_LEG          2
+
+/* User data of the wakeup poll, a tag without an operation. */
+#define PROACTOR_WAKEUP PROACTOR_TAG_MASK
+
+/*
+ * Messages posted by other rings through IORING_OP_MSG_RING carry the
+ * address of their Channel with the top bit set, which user space
+ * addresses never have on Linux.
+ */
+#define PROACTOR_MESSAGE ((uint64_t)1 << 63)
+
+static inline uint64_t proactor_tag(Operation *op, unsigned tag) {
+    return (uint64_t)(uintptr_t)op | tag;
+}
+
 int proactor_init(Proactor *proactor, RunConfig *config);
 void proactor_exit(Proactor *proactor);
 int proactor_enable(Proactor *proactor);
 
+/*
+ * Cancels what is still in flight and brings an idle ring back into
+ * the state of a fresh one, keeping its mappings and registrations.
+ * Returns false without raising if the ring can't be reused.
+ */
+bool proactor_reset(Proactor *proactor, unsigned int ftable_size);
+
+/*
+ * Keeps a multishot poll for fd armed, so that making it readable from
+ * another thread ends a blocking wait in proactor_run. The poll does not
+ * count towards the pending events.
+ */
+void proactor_set_wakeup(Proactor *proactor, int fd);
+
 bool proactor_can_submit(Proactor *proactor, unsigned nentries);
 struct io_uring_sqe *proactor_get_submission(Proactor *proactor);
+
+/*
+ * Makes sure that nentries submissions fit into the queue without a
+ * batch boundary in between, which would break linked submissions.
+ */
+bool proactor_reserve(Proactor *proactor, unsigned nentries);
+
+/*
+ * Prepares a submission for op with the extra IOSQE_* flags, followed
+ * by its linked timeout if one was requested. Takes a reference to op
+ * for the linked timeout, the caller provides the one for op itself.
+ */
+int proactor_push_operation(Proactor *proactor, Operation *op, unsigned char flags);
+
+/* The number of submission entries proactor_push_operation uses for op. */
+static inline unsigned proactor_operation_size(Operation *op) {
+    return op->timeout_state == Timeout_Pending ? 2 : 1;
+}
+
 int proactor_submit(Proactor *proactor);
 
-int proactor_run(Proactor *proactor, TaskList *list, unsigned long timeout);
+/*
+ * Submits pending entries and reaps completions into list. Blocks for
+ * at most timeout_ms milliseconds until one arrives, or indefinitely
+ * when timeout_ms is negative. A timeout of 0 never blocks.
+ */
+int proactor_run(Proactor *proactor, TaskList *list, long long timeout_ms);
@@ -13,7 +13,15 @@ PyDoc_STRVAR(g_run_config_doc, "Configuration for the runtime context.\n\n"
 PyDoc_STRVAR(g_run_config_sq_size_doc, "The capacity of the io_uring submission queue.");
 PyDoc_STRVAR(g_run_config_cq_size_doc, "The capacity of the io_uring completion queue.");
 PyDoc_STRVAR(g_run_config_ftable_size_doc, "The number of direct descriptors managed by this ring instance.");
+PyDoc_STRVAR(g_run_config_pbuf_count_doc, "The number of buffers in the provided buffer ring, or 0 to disable it.");
+PyDoc_STRVAR(g_run_config_pbuf_size_doc, "The size in bytes of each buffer in the provided buffer ring.");
+PyDoc_STRVAR(g_run_config_fbuf_count_doc, "The number of registered fixed buffers, or 0 to disable them.");
+PyDoc_STRVAR(g_run_config_fbuf_size_doc, "The size in bytes of each registered fixed buffer.");
 PyDoc_STRVAR(g_run_config_wqfd_doc, "The fd of an existing io_uring instance whose work queue should be shared.");
+PyDoc_STRVAR(g_run_config_step_budget_doc, "The number of task resumes before the ring is serviced again, or 0 for no limit.");
+PyDoc_STRVAR(g_run_config_task_budget_doc, "The number of awaits a task may complete without yielding, or 0 for no limit.");
+PyDoc_STRVAR(g_run_config_workers_doc, "The number of worker threads, more than 1 requires a free-threaded build.");
+PyDoc_STRVAR(g_run_config_persistent_doc, "Whether the runtime outlives run() for reuse by the next compatible run on this thread.");
 
 static int run_config_traverse(PyObject *self, visitproc visit, void *arg) {
     Py_VISIT(Py_TYPE(self));
@@ -34,7 +42,15 @@ static int run_config_init(PyObject *self, PyObject *args, PyObject *kwds) {
     conf->sq_size     = 0;
     conf->cq_size     = 0;
     conf->ftable_size = 0;
+    conf->pbuf_count  = 0;
+    conf->pbuf_size   = 4096;
+    conf->fbuf_count  = 0;
+    conf->fbuf_size   = 65536;
     conf->wqfd        = -1;
+    conf->step_budget = 128;
+    conf->task_budget = 128;
+    conf->workers     = 1;
+    conf->persistent  = false;
     return 0;
 }
 
@@ -42,7 +58,15 @@ static PyMemberDef g_run_config_members[] = {
     {"sq_size", Py_T_UINT, offsetof(RunConfig, sq_size), 0, g_run_config_sq_size_doc},
     {"cq_size", Py_T_UINT, offsetof(RunConfig, cq_size), 0, g_run_config_cq_size_doc},
     {"ftable_size", Py_T_UINT, offsetof(RunConfig, ftable_size), 0, g_run_config_ftable_size_doc},
+    {"pbuf_count", Py_T_UINT, offsetof(RunConfig, pbuf_count), 0, g_run_config_pbuf_count_doc},
+    {"pbuf_size", Py_T_UINT, offsetof(RunConfig, pbuf_size), 0, g_run_config_pbuf_size_doc},
+    {"fbuf_count", Py_T_UINT, offsetof(RunConfig, fbuf_count), 0, g_run_config_fbuf_count_doc},
+    {"fbuf_size", Py_T_UINT, offsetof(RunConfig, fbuf_size), 0, g_run_config_fbuf_size_doc},
     {"wqfd", Py_T_INT, offsetof(RunConfig, wqfd), 0, g_run_config_wqfd_doc},
+    {"step_budget", Py_T_UINT, offsetof(RunConfig, step_budget), 0, g_run_config_step_budget_doc},
+    {"task_budget", Py_T_UINT, offsetof(RunConfig, task_budget), 0, g_run_config_task_budget_doc},
+    {"workers", Py_T_UINT, offsetof(RunConfig, workers), 0, g_run_config_workers_doc},
+    {"persistent", Py_T_BOOL, offsetof(RunConfig, persistent), 0, g_run_config_persistent_doc},
     {NULL, 0, 0, 0, NULL},
 };
 
@@ -12,7 +12,15 @@ typedef struct {
     unsigned int sq_size;
     unsigned int cq_size;
     unsigned int ftable_size;
+    unsigned int pbuf_count;
+    unsigned int pbuf_size;
+    unsigned int fbuf_count;
+    unsigned int fbuf_size;
     int wqfd;
+    unsigned int step_budget;
+    unsigned int task_budget;
+    unsigned int workers;
+    bool persistent;
 } RunConfig;
 
 /* Registers RunConfig as a Python class onto the module. */
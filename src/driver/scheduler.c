@@ -0,0 +1,491 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "driver/scheduler.h"
+
+#ifdef Py_GIL_DISABLED
+
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "driver/handle.h"
+
+typedef struct _Scheduler Scheduler;
+
+struct _Worker {
+    Scheduler *sched;
+    unsigned index;
+    pthread_t thread;
+    bool started;
+    RunState rs;
+    /* Guards the two queues below, which other workers access too. */
+    PyMutex lock;
+    /* Tasks this worker offers to the others for stealing. */
+    TaskList shared;
+    /* Tasks bound to this worker that another worker woke up. */
+    TaskList inbox;
+    /* An eventfd polled by the ring, written to end a blocking wait. */
+    int wakeup_fd;
+    int notified;
+    /* Guarded by the scheduler lock. */
+    bool parked;
+    bool stalled;
+};
+
+struct _Scheduler {
+    PyInterpreterState *interp;
+    Worker *workers;
+    unsigned nworkers;
+    /*
+     * Guards the parking state of all workers, and the waiter lists of
+     * tasks that are joined and finished on different workers.
+     */
+    PyMutex lock;
+    /* Workers blocked in their ring, and those with nothing in flight. */
+    unsigned parked;
+    unsigned stalled;
+    /* Set once the root task finished or a worker failed. */
+    bool shutdown;
+    LoopStatus status;
+    PyObject *result;
+    PyObject *error;
+};
+
+/* Worker implementation */
+
+static void worker_wake(Worker *w) {
+    /* Only the first wakeup until the worker noticed it needs a syscall. */
+    if (__atomic_exchange_n(&w->notified, 1, __ATOMIC_ACQ_REL) == 0) {
+        (void)eventfd_write(w->wakeup_fd, 1);
+    }
+}
+
+static void worker_reset_wakeup(Worker *w) {
+    eventfd_t value;
+
+    if (__atomic_exchange_n(&w->notified, 0, __ATOMIC_ACQ_REL) != 0) {
+        (void)eventfd_read(w->wakeup_fd, &value);
+    }
+}
+
+/* Must be called with the scheduler lock held. */
+static void scheduler_unpark(Scheduler *sched, Worker *w) {
+    if (!w->parked) {
+        return;
+    }
+
+    w->parked = false;
+    __atomic_sub_fetch(&sched->parked, 1, __ATOMIC_RELAXED);
+
+    if (w->stalled) {
+        w->stalled = false;
+        --sched->stalled;
+    }
+}
+
+static void worker_inject(Worker *w, Task *task) {
+    Scheduler *sched = w->sched;
+
+    PyMutex_Lock(&w->lock);
+    task_list_push_back(&w->inbox, task);
+    PyMutex_Unlock(&w->lock);
+
+    PyMutex_Lock(&sched->lock);
+    scheduler_unpark(sched, w);
+    PyMutex_Unlock(&sched->lock);
+
+    worker_wake(w);
+}
+
+static void worker_drain_inbox(Worker *w) {
+    PyMutex_Lock(&w->lock);
+    task_list_append(&w->rs.rt->run_queue, &w->inbox);
+    PyMutex_Unlock(&w->lock);
+}
+
+static void worker_publish(Worker *w) {
+    Scheduler *sched = w->sched;
+    Worker *thief    = NULL;
+    bool offered     = false;
+
+    /*
+     * Offer half of the run queue, but only once the others took what
+     * we offered last time. The LIFO slot always stays with us.
+     */
+    PyMutex_Lock(&w->lock);
+    if (task_list_empty(&w->shared)) {
+        task_list_split(&w->rs.rt->run_queue, &w->shared);
+        offered = !task_list_empty(&w->shared);
+    }
+    PyMutex_Unlock(&w->lock);
+
+    if (!offered) {
+        return;
+    }
+
+    PyMutex_Lock(&sched->lock);
+    for (unsigned i = 1; i < sched->nworkers; ++i) {
+        Worker *other = &sched->workers[(w->index + i) % sched->nworkers];
+        if (other->parked) {
+            scheduler_unpark(sched, other);
+            thief = other;
+            break;
+        }
+    }
+    PyMutex_Unlock(&sched->lock);
+
+    if (thief != NULL) {
+        worker_wake(thief);
+    }
+}
+
+static bool worker_steal(Worker *w) {
+    Scheduler *sched = w->sched;
+    TaskList *queue  = &w->rs.rt->run_queue;
+
+    /* Take back our own offers first, then look at the other workers. */
+    for (unsigned i = 0; i < sched->nworkers; ++i) {
+        Worker *victim = &sched->workers[(w->index + i) % sched->nworkers];
+
+        PyMutex_Lock(&victim->lock);
+        if (victim == w) {
+            task_list_append(queue, &w->inbox);
+        }
+        task_list_append(queue, &victim->shared);
+        PyMutex_Unlock(&victim->lock);
+
+        if (!task_list_empty(queue)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Registers the worker as blocked in its ring before it waits. Returns
+ * 1 if it may block, 0 if work showed up in the meantime and -1 if all
+ * workers are stuck with nothing in flight.
+ */
+static int worker_park(Worker *w, bool idle) {
+    Scheduler *sched = w->sched;
+    int rc           = 1;
+
+    PyMutex_Lock(&sched->lock);
+    if (sched->shutdown) {
+        rc = 0;
+    }
+
+    for (unsigned i = 0; rc == 1 && i < sched->nworkers; ++i) {
+        Worker *other = &sched->workers[i];
+
+        PyMutex_Lock(&other->lock);
+        if (!task_list_empty(&other->shared) || (other == w && !task_list_empty(&w->inbox))) {
+            rc = 0;
+        }
+        PyMutex_Unlock(&other->lock);
+    }
+
+    if (rc == 1) {
+        w->parked = true;
+        __atomic_add_fetch(&sched->parked, 1, __ATOMIC_RELAXED);
+
+        if (idle) {
+            w->stalled = true;
+            if (++sched->stalled == sched->nworkers) {
+                rc = -1;
+            }
+        }
+    }
+    PyMutex_Unlock(&sched->lock);
+
+    if (rc < 0) {
+        PyErr_SetString(PyExc_RuntimeError, "Deadlock: no pending events and no ready tasks");
+    }
+
+    return rc;
+}
+
+static void scheduler_stop(Scheduler *sched, LoopStatus status, PyObject *result) {
+    PyObject *error = status == LOOP_ERROR ? PyErr_GetRaisedException() : NULL;
+    bool first;
+
+    PyMutex_Lock(&sched->lock);
+    first = !sched->shutdown;
+    if (first) {
+        sched->status = status;
+        sched->result = result;
+        sched->error  = error;
+        __atomic_store_n(&sched->shutdown, true, __ATOMIC_RELEASE);
+    }
+
+    for (unsigned i = 0; i < sched->nworkers; ++i) {
+        scheduler_unpark(sched, &sched->workers[i]);
+    }
+    PyMutex_Unlock(&sched->lock);
+
+    for (unsigned i = 0; i < sched->nworkers; ++i) {
+        worker_wake(&sched->workers[i]);
+    }
+
+    /* Only the first outcome is reported to the caller of run(). */
+    if (!first) {
+        Py_XDECREF(result);
+        if (error != NULL) {
+            PyErr_SetRaisedException(error);
+            PyErr_WriteUnraisable(NULL);
+        }
+    }
+}
+
+static LoopStatus worker_step(Worker *w) {
+    Scheduler *sched  = w->sched;
+    RuntimeHandle *rt = w->rs.rt;
+
+    worker_drain_inbox(w);
+
+    LoopStatus status = event_loop_run_tasks(&w->rs);
+    if (status != LOOP_CONTINUE) {
+        return status;
+    }
+
+    if (__atomic_load_n(&sched->parked, __ATOMIC_RELAXED) > 0) {
+        worker_publish(w);
+    }
+
+    bool has_ready = !task_list_empty(&rt->run_queue) || rt->lifo_slot != NULL;
+    if (!has_ready) {
+        has_ready = worker_steal(w);
+    }
+
+    bool has_timers   = !timer_wheel_empty(&rt->timers);
+    long long timeout = -1;
+    if (has_ready) {
+        timeout = 0;
+    } else if (has_timers) {
+        timeout = runtime_next_timeout(rt);
+    }
+
+    /*
+     * A worker without anything in flight blocks until another worker
+     * wakes it up. If that is true for all of them, nobody ever will.
+     */
+    bool parked = false;
+    if (timeout != 0) {
+        int rc = worker_park(w, rt->proactor.pending_events == 0 && !has_timers && rt->channel_waiters == 0);
+        if (rc < 0) {
+            return LOOP_ERROR;
+        }
+
+        parked = rc > 0;
+        if (!parked) {
+            timeout = 0;
+        }
+    }
+
+    if (rt->proactor.pending_events > 0 || timeout != 0) {
+        TaskList woken;
+        task_list_init(&woken);
+
+        int res = proactor_run(&rt->proactor, &woken, timeout);
+        if (parked) {
+            PyMutex_Lock(&sched->lock);
+            scheduler_unpark(sched, w);
+            PyMutex_Unlock(&sched->lock);
+        }
+
+        worker_reset_wakeup(w);
+        runtime_wake(rt, &woken);
+        if (res != 0) {
+            return LOOP_ERROR;
+        }
+    }
+
+    if (has_timers) {
+        runtime_fire_timers(rt);
+    }
+
+    return LOOP_CONTINUE;
+}
+
+static void worker_run(Worker *w) {
+    Scheduler *sched  = w->sched;
+    RunState *rs      = &w->rs;
+    LoopStatus status = LOOP_ERROR;
+
+    rs->rt = runtime_enter(rs->state, rs->config);
+    if (rs->rt != NULL) {
+        rs->rt->worker = w;
+        proactor_set_wakeup(&rs->rt->proactor, w->wakeup_fd);
+
+        /* The root task starts out on the first worker. */
+        if (w->index == 0) {
+            task_list_push_back(&rs->rt->run_queue, rs->root);
+        }
+
+        do {
+            status = worker_step(w);
+            if (status == LOOP_CONTINUE && PyErr_CheckSignals() < 0) {
+                status = LOOP_ERROR;
+            }
+        } while (status == LOOP_CONTINUE && !__atomic_load_n(&sched->shutdown, __ATOMIC_ACQUIRE));
+    }
+
+    if (status != LOOP_CONTINUE) {
+        scheduler_stop(sched, status, rs->result);
+        rs->result = NULL;
+    }
+
+    /* The ring may only be torn down by the thread that created it. */
+    runtime_exit(rs->state);
+    rs->rt = NULL;
+}
+
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+
+    PyThreadState *tstate = PyThreadState_New(w->sched->interp);
+    PyEval_RestoreThread(tstate);
+
+    worker_run(w);
+
+    PyThreadState_Clear(tstate);
+    PyThreadState_DeleteCurrent();
+    return NULL;
+}
+
+/* Scheduler implementation */
+
+LoopStatus scheduler_run(RunState *rs) {
+    RunConfig *config = rs->config;
+    Scheduler sched;
+
+    /* These resources live in the ring of a single worker. */
+    if (config->ftable_size > 0 || config->pbuf_count > 0 || config->fbuf_count > 0) {
+        PyErr_SetString(PyExc_ValueError, "Direct descriptors and registered buffers require a single worker");
+        return LOOP_ERROR;
+    }
+
+    memset(&sched, 0, sizeof(sched));
+    sched.interp   = PyInterpreterState_Get();
+    sched.nworkers = config->workers;
+    sched.status   = LOOP_ERROR;
+
+    sched.workers = PyMem_Calloc(sched.nworkers, sizeof(Worker));
+    if (sched.workers == NULL) {
+        PyErr_SetNone(PyExc_MemoryError);
+        return LOOP_ERROR;
+    }
+
+    for (unsigned i = 0; i < sched.nworkers; ++i) {
+        Worker *w = &sched.workers[i];
+
+        w->sched     = &sched;
+        w->index     = i;
+        w->rs.state  = rs->state;
+        w->rs.config = config;
+        w->rs.root   = rs->root;
+        task_list_init(&w->shared);
+        task_list_init(&w->inbox);
+
+        w->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (w->wakeup_fd < 0) {
+            PyErr_SetFromErrno(PyExc_OSError);
+            sched.nworkers = i;
+            scheduler_stop(&sched, LOOP_ERROR, NULL);
+            break;
+        }
+    }
+
+    /* The calling thread doubles as the first worker. */
+    for (unsigned i = 1; i < sched.nworkers && !__atomic_load_n(&sched.shutdown, __ATOMIC_ACQUIRE); ++i) {
+        Worker *w = &sched.workers[i];
+
+        int res = pthread_create(&w->thread, NULL, worker_main, w);
+        if (res != 0) {
+            errno = res;
+            PyErr_SetFromErrno(PyExc_OSError);
+            scheduler_stop(&sched, LOOP_ERROR, NULL);
+            break;
+        }
+
+        w->started = true;
+    }
+
+    if (!__atomic_load_n(&sched.shutdown, __ATOMIC_ACQUIRE)) {
+        worker_run(&sched.workers[0]);
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    for (unsigned i = 1; i < sched.nworkers; ++i) {
+        if (sched.workers[i].started) {
+            pthread_join(sched.workers[i].thread, NULL);
+        }
+    }
+    Py_END_ALLOW_THREADS
+
+    /* Nobody is left to resume the tasks that were still queued up. */
+    for (unsigned i = 0; i < sched.nworkers; ++i) {
+        Worker *w = &sched.workers[i];
+
+        task_list_clear(&w->shared);
+        task_list_clear(&w->inbox);
+        close(w->wakeup_fd);
+    }
+    PyMem_Free(sched.workers);
+
+    if (sched.status == LOOP_DONE) {
+        rs->result = sched.result;
+    } else {
+        PyErr_SetRaisedException(sched.error);
+    }
+
+    return sched.status;
+}
+
+int scheduler_join(Worker *worker, Task *task, Task *waiter) {
+    Scheduler *sched = worker->sched;
+
+    PyMutex_Lock(&sched->lock);
+    int rc = task_join(task, waiter, &worker->rs.rt->run_queue);
+    PyMutex_Unlock(&sched->lock);
+
+    return rc;
+}
+
+void scheduler_finish(Worker *worker, Task *task, PyObject *result) {
+    Scheduler *sched = worker->sched;
+    TaskList woken;
+
+    task_list_init(&woken);
+
+    PyMutex_Lock(&sched->lock);
+    task_finish(task, result, &woken);
+    PyMutex_Unlock(&sched->lock);
+
+    while (!task_list_empty(&woken)) {
+        Task *waiter = task_list_pop_front(&woken);
+
+        if (waiter->home == NULL || waiter->home == worker) {
+            task_list_push_back(&worker->rs.rt->run_queue, waiter);
+        } else {
+            worker_inject(waiter->home, waiter);
+        }
+
+        Py_DECREF(waiter);
+    }
+}
+
+#else
+
+LoopStatus scheduler_run(RunState *rs) {
+    (void)rs;
+
+    PyErr_SetString(PyExc_RuntimeError, "Multiple workers require a free-threaded build of Python");
+    return LOOP_ERROR;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+#include "run.h"
+#include "task.h"
+
+/*
+ * The multi-threaded runtime flavor. Every worker thread enters a
+ * runtime of its own with a separate ring, and idle workers steal the
+ * tasks that busy ones offer. This requires a free-threaded build, the
+ * workers would only take turns holding the GIL otherwise.
+ */
+typedef struct _Worker Worker;
+
+/*
+ * Drives the root task of rs to completion on rs->config->workers
+ * threads, the calling thread being the first of them.
+ */
+LoopStatus scheduler_run(RunState *rs);
+
+#ifdef Py_GIL_DISABLED
+
+/* Like task_join, for a task that may finish on another worker. */
+int scheduler_join(Worker *worker, Task *task, Task *waiter);
+
+/* Like task_finish, but waiters bound to other workers run over there. */
+void scheduler_finish(Worker *worker, Task *task, PyObject *result);
+
+#endif
@@ -0,0 +1,246 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "driver/timer.h"
+
+#include <assert.h>
+#include <time.h>
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+/*
+ * The furthest distance to the current time the wheel can represent.
+ * This stops one slot short of a full rotation of the top level, so
+ * that clamped timers never share the current slot with others.
+ */
+#define MAX_DURATION ((uint64_t)SLOT_MASK << (TIMER_WHEEL_SLOT_BITS * (TIMER_WHEEL_LEVELS - 1)))
+
+static inline void entry_init(TimerEntry *self) {
+    self->prev = self;
+    self->next = self;
+}
+
+static inline bool entry_list_empty(TimerEntry *head) {
+    return head->next == head;
+}
+
+static inline void entry_list_push(TimerEntry *head, TimerEntry *entry) {
+    entry->prev      = head->prev;
+    entry->next      = head;
+    head->prev->next = entry;
+    head->prev       = entry;
+}
+
+static inline void entry_unlink(TimerEntry *entry) {
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry_init(entry);
+}
+
+static inline unsigned int slot_for(uint64_t when, unsigned int level) {
+    return (when >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK;
+}
+
+static inline unsigned int level_for(uint64_t elapsed, uint64_t when) {
+    /* The highest bit that differs from now picks the level. */
+    uint64_t masked = (elapsed ^ when) | SLOT_MASK;
+    unsigned int significant = 63 - __builtin_clzll(masked);
+    unsigned int level       = significant / TIMER_WHEEL_SLOT_BITS;
+
+    return level < TIMER_WHEEL_LEVELS ? level : TIMER_WHEEL_LEVELS - 1;
+}
+
+static void wheel_place(TimerWheel *self, TimerEntry *entry) {
+    uint64_t when = entry->deadline;
+
+    /* Deadlines beyond the range of the wheel get re-placed later. */
+    if (when - self->elapsed > MAX_DURATION) {
+        when = self->elapsed + MAX_DURATION;
+    }
+
+    unsigned int level = level_for(self->elapsed, when);
+    unsigned int slot  = slot_for(when, level);
+
+    entry_list_push(&self->slots[level][slot], entry);
+    self->occupied[level] |= 1ULL << slot;
+}
+
+uint64_t timer_clock_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void timer_wheel_init(TimerWheel *self, uint64_t now) {
+    self->elapsed = now;
+    self->count   = 0;
+
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        self->occupied[level] = 0;
+        for (unsigned int slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot) {
+            entry_init(&self->slots[level][slot]);
+        }
+    }
+
+    entry_init(&self->expired);
+}
+
+bool timer_wheel_insert(TimerWheel *self, TimerEntry *entry) {
+    if (entry->deadline <= self->elapsed) {
+        return false;
+    }
+
+    wheel_place(self, entry);
+    ++self->count;
+    return true;
+}
+
+void timer_wheel_remove(TimerWheel *self, TimerEntry *entry) {
+    TimerEntry *next = entry->next;
+
+    entry_unlink(entry);
+    --self->count;
+
+    /* Clear the occupied bit when this was the last timer in its slot. */
+    if (entry_list_empty(next)) {
+        for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+            TimerEntry *base = self->slots[level];
+            if (next >= base && next < base + TIMER_WHEEL_SLOTS) {
+                self->occupied[level] &= ~(1ULL << (next - base));
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Finds the next slot which needs processing. Lower levels always
+ * expire before the next slot of any higher level does, so the first
+ * level with an occupied slot holds the earliest expiration.
+ */
+static bool wheel_next_slot(TimerWheel *self, unsigned int *out_level, uint64_t *out_when) {
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        uint64_t occupied = self->occupied[level];
+        if (occupied == 0) {
+            continue;
+        }
+
+        unsigned int shift = level * TIMER_WHEEL_SLOT_BITS;
+        unsigned int now   = slot_for(self->elapsed, level);
+
+        /* Rotate so that bit 0 is the current slot of this level. */
+        uint64_t rotated  = now != 0 ? (occupied >> now) | (occupied << (TIMER_WHEEL_SLOTS - now)) : occupied;
+        unsigned int slot = (now + __builtin_ctzll(rotated)) & SLOT_MASK;
+
+        uint64_t level_range = 1ULL << (shift + TIMER_WHEEL_SLOT_BITS);
+        uint64_t when        = (self->elapsed & ~(level_range - 1)) + ((uint64_t)slot << shift);
+
+        /* Only clamped timers wrap around into the next rotation. */
+        if (when <= self->elapsed) {
+            when += level_range;
+        }
+
+        *out_level = level;
+        *out_when  = when;
+        return true;
+    }
+
+    return false;
+}
+
+uint64_t timer_wheel_next_expiration(TimerWheel *self) {
+    unsigned int level;
+    uint64_t when;
+
+    if (!entry_list_empty(&self->expired)) {
+        return self->elapsed;
+    }
+
+    if (!wheel_next_slot(self, &level, &when)) {
+        return UINT64_MAX;
+    }
+
+    return when;
+}
+
+static void wheel_process_slot(TimerWheel *self, unsigned int level, uint64_t when) {
+    unsigned int slot = slot_for(when, level);
+    TimerEntry *head  = &self->slots[level][slot];
+
+    self->occupied[level] &= ~(1ULL << slot);
+    self->elapsed = when;
+
+    /* Detach the slot first, clamped timers may land in it again. */
+    TimerEntry pending;
+    entry_init(&pending);
+    if (!entry_list_empty(head)) {
+        pending.next       = head->next;
+        pending.prev       = head->prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        entry_init(head);
+    }
+
+    /*
+     * Timers which are due go to the expired list, the others cascade
+     * down to the lower levels which now cover their deadline.
+     */
+    while (!entry_list_empty(&pending)) {
+        TimerEntry *entry = pending.next;
+        entry_unlink(entry);
+
+        if (entry->deadline <= when) {
+            entry_list_push(&self->expired, entry);
+        } else {
+            wheel_place(self, entry);
+        }
+    }
+}
+
+TimerEntry *timer_wheel_poll(TimerWheel *self, uint64_t now) {
+    unsigned int level;
+    uint64_t when;
+
+    while (entry_list_empty(&self->expired)) {
+        if (!wheel_next_slot(self, &level, &when) || when > now) {
+            if (now > self->elapsed) {
+                self->elapsed = now;
+            }
+            return NULL;
+        }
+
+        wheel_process_slot(self, level, when);
+    }
+
+    TimerEntry *entry = self->expired.next;
+    entry_unlink(entry);
+    --self->count;
+    return entry;
+}
+
+TimerEntry *timer_wheel_pop_any(TimerWheel *self) {
+    if (!entry_list_empty(&self->expired)) {
+        TimerEntry *entry = self->expired.next;
+        entry_unlink(entry);
+        --self->count;
+        return entry;
+    }
+
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        while (self->occupied[level] != 0) {
+            unsigned int slot = __builtin_ctzll(self->occupied[level]);
+            TimerEntry *head  = &self->slots[level][slot];
+
+            if (!entry_list_empty(head)) {
+                TimerEntry *entry = head->next;
+                timer_wheel_remove(self, entry);
+                return entry;
+            }
+
+            self->occupied[level] &= ~(1ULL << slot);
+        }
+    }
+
+    return NULL;
+}
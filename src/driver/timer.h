@@ -0,0 +1,73 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+#include <stdint.h>
+
+/* Number of slots per level and number of levels in the wheel. */
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS     (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVELS    6
+
+/* An intrusive timer node, embedded into the object it wakes. */
+typedef struct _TimerEntry {
+    struct _TimerEntry *prev;
+    struct _TimerEntry *next;
+    uint64_t deadline;
+} TimerEntry;
+
+/*
+ * A hierarchical timer wheel with millisecond resolution.
+ *
+ * Every level splits the range of the level above into 64 slots, so
+ * level 0 covers the next 64ms slot by slot, level 1 the next 4s in
+ * 64ms slots, and so on. Timers are inserted into the lowest level
+ * that can tell their deadline apart from the current time, and move
+ * down the levels as their deadline approaches. Insertion and removal
+ * are O(1), and finding the next expiration only scans bitmaps.
+ */
+typedef struct {
+    uint64_t elapsed;
+    size_t count;
+    uint64_t occupied[TIMER_WHEEL_LEVELS];
+    TimerEntry slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    TimerEntry expired;
+} TimerWheel;
+
+/* Returns the current time of the monotonic clock in nanoseconds. */
+uint64_t timer_clock_ns(void);
+
+/* Initializes an empty wheel starting at the given time in ms. */
+void timer_wheel_init(TimerWheel *self, uint64_t now);
+
+/* Checks if there are no timers left in the wheel. */
+static inline bool timer_wheel_empty(TimerWheel *self) {
+    return self->count == 0;
+}
+
+/*
+ * Adds a timer with the deadline already stored in entry. Returns false
+ * if the deadline has passed, in which case the timer is not added.
+ */
+bool timer_wheel_insert(TimerWheel *self, TimerEntry *entry);
+
+/* Removes a timer which is currently in the wheel. */
+void timer_wheel_remove(TimerWheel *self, TimerEntry *entry);
+
+/*
+ * Returns the earliest point in time in ms at which the wheel needs to
+ * be polled again, or UINT64_MAX if it is empty.
+ */
+uint64_t timer_wheel_next_expiration(TimerWheel *self);
+
+/*
+ * Advances the wheel to now and returns the next expired timer, which
+ * is removed from the wheel. Returns NULL when none are left.
+ */
+TimerEntry *timer_wheel_poll(TimerWheel *self, uint64_t now);
+
+/* Removes and returns any timer in the wheel, or NULL if empty. */
+TimerEntry *timer_wheel_pop_any(TimerWheel *self);
@@ -5,25 +5,34 @@
 
 #include <assert.h>
 
+#include "channel.h"
+#include "driver/buffers.h"
 #include "driver/run_config.h"
 #include "op/accept.h"
 #include "op/base.h"
 #include "op/bind.h"
 #include "op/cancel.h"
+#include "op/chain.h"
 #include "op/close.h"
 #include "op/connect.h"
 #include "op/fsync.h"
 #include "op/linkat.h"
 #include "op/listen.h"
 #include "op/mkdir.h"
+#include "op/msg_ring.h"
+#include "op/multishot.h"
 #include "op/nop.h"
 #include "op/open.h"
 #include "op/read.h"
 #include "op/recv.h"
+#include "op/relay.h"
 #include "op/rename.h"
 #include "op/send.h"
+#include "op/sendfile.h"
+#include "op/sleep.h"
 #include "op/socket.h"
 #include "op/sockopt.h"
+#include "op/splice.h"
 #include "op/statx.h"
 #include "op/symlinkat.h"
 #include "op/unlinkat.h"
@@ -34,14 +43,28 @@
 static int module_traverse(PyObject *mod, visitproc visit, void *arg) {
     ImplState *state = PyModule_GetState(mod);
     Py_VISIT(state->RunConfig_type);
+    Py_VISIT(state->BufferRing_type);
+    Py_VISIT(state->FixedBufferPool_type);
+    Py_VISIT(state->LeasedBuffer_type);
     Py_VISIT(state->Task_type);
+    Py_VISIT(state->Channel_type);
+    Py_VISIT(state->Dispatcher_type);
     Py_VISIT(state->Operation_type);
-    Py_VISIT(state->OperationWaiter_type);
+    Py_VISIT(state->MultishotOperation_type);
+    Py_VISIT(state->ChainOperation_type);
+    Py_VISIT(state->RelayOperation_type);
     Py_VISIT(state->NopOperation_type);
+    Py_VISIT(state->MsgRingOperation_type);
+    Py_VISIT(state->SleepOperation_type);
     Py_VISIT(state->SocketOperation_type);
     Py_VISIT(state->OpenAtOperation_type);
     Py_VISIT(state->ReadOperation_type);
     Py_VISIT(state->WriteOperation_type);
+    Py_VISIT(state->ReadIntoOperation_type);
+    Py_VISIT(state->ReadvOperation_type);
+    Py_VISIT(state->ReadFixedOperation_type);
+    Py_VISIT(state->WritevOperation_type);
+    Py_VISIT(state->WriteFixedOperation_type);
     Py_VISIT(state->CloseOperation_type);
     Py_VISIT(state->CancelOperation_type);
     Py_VISIT(state->ConnectOperation_type);
@@ -52,10 +75,20 @@ static int module_traverse(PyObject *mod, visitproc visit, void *arg) {
     Py_VISIT(state->UnlinkAtOperation_type);
     Py_VISIT(state->SymlinkAtOperation_type);
     Py_VISIT(state->AcceptOperation_type);
+    Py_VISIT(state->AcceptMultishotOperation_type);
     Py_VISIT(state->BindOperation_type);
     Py_VISIT(state->ListenOperation_type);
     Py_VISIT(state->SendOperation_type);
+    Py_VISIT(state->SendmsgOperation_type);
+    Py_VISIT(state->SendZcOperation_type);
+    Py_VISIT(state->SendfileOperation_type);
     Py_VISIT(state->RecvOperation_type);
+    Py_VISIT(state->RecvIntoOperation_type);
+    Py_VISIT(state->RecvmsgOperation_type);
+    Py_VISIT(state->RecvBufferOperation_type);
+    Py_VISIT(state->RecvMultishotOperation_type);
+    Py_VISIT(state->SpliceOperation_type);
+    Py_VISIT(state->TeeOperation_type);
     Py_VISIT(state->StatxResult_type);
     Py_VISIT(state->StatxOperation_type);
     Py_VISIT(state->GetsockoptOperation_type);
@@ -66,14 +99,28 @@ static int module_traverse(PyObject *mod, visitproc visit, void *arg) {
 static int module_clear(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     Py_CLEAR(state->RunConfig_type);
+    Py_CLEAR(state->BufferRing_type);
+    Py_CLEAR(state->FixedBufferPool_type);
+    Py_CLEAR(state->LeasedBuffer_type);
     Py_CLEAR(state->Task_type);
+    Py_CLEAR(state->Channel_type);
+    Py_CLEAR(state->Dispatcher_type);
     Py_CLEAR(state->Operation_type);
-    Py_CLEAR(state->OperationWaiter_type);
+    Py_CLEAR(state->MultishotOperation_type);
+    Py_CLEAR(state->ChainOperation_type);
+    Py_CLEAR(state->RelayOperation_type);
     Py_CLEAR(state->NopOperation_type);
+    Py_CLEAR(state->MsgRingOperation_type);
+    Py_CLEAR(state->SleepOperation_type);
     Py_CLEAR(state->SocketOperation_type);
     Py_CLEAR(state->OpenAtOperation_type);
     Py_CLEAR(state->ReadOperation_type);
     Py_CLEAR(state->WriteOperation_type);
+    Py_CLEAR(state->ReadIntoOperation_type);
+    Py_CLEAR(state->ReadvOperation_type);
+    Py_CLEAR(state->ReadFixedOperation_type);
+    Py_CLEAR(state->WritevOperation_type);
+    Py_CLEAR(state->WriteFixedOperation_type);
     Py_CLEAR(state->CloseOperation_type);
     Py_CLEAR(state->CancelOperation_type);
     Py_CLEAR(state->ConnectOperation_type);
@@ -84,14 +131,25 @@ static int module_clear(PyObject *mod) {
     Py_CLEAR(state->UnlinkAtOperation_type);
     Py_CLEAR(state->SymlinkAtOperation_type);
     Py_CLEAR(state->AcceptOperation_type);
+    Py_CLEAR(state->AcceptMultishotOperation_type);
     Py_CLEAR(state->BindOperation_type);
     Py_CLEAR(state->ListenOperation_type);
     Py_CLEAR(state->SendOperation_type);
+    Py_CLEAR(state->SendmsgOperation_type);
+    Py_CLEAR(state->SendZcOperation_type);
+    Py_CLEAR(state->SendfileOperation_type);
     Py_CLEAR(state->RecvOperation_type);
+    Py_CLEAR(state->RecvIntoOperation_type);
+    Py_CLEAR(state->RecvmsgOperation_type);
+    Py_CLEAR(state->RecvBufferOperation_type);
+    Py_CLEAR(state->RecvMultishotOperation_type);
+    Py_CLEAR(state->SpliceOperation_type);
+    Py_CLEAR(state->TeeOperation_type);
     Py_CLEAR(state->StatxResult_type);
     Py_CLEAR(state->StatxOperation_type);
     Py_CLEAR(state->GetsockoptOperation_type);
     Py_CLEAR(state->SetsockoptOperation_type);
+    errno_cache_clear(&state->errno_cache);
     return 0;
 }
 
@@ -101,6 +159,7 @@ static void module_free(void *mod) {
     PyThread_tss_free(state->local_handle);
 
     module_clear(mod);
+    operation_freelist_clear(&state->freelist);
 }
 
 static int module_exec(PyObject *mod) {
@@ -111,18 +170,53 @@ static int module_exec(PyObject *mod) {
         return -1;
     }
 
+    state->BufferRing_type = buffer_ring_register(mod);
+    if (state->BufferRing_type == NULL) {
+        return -1;
+    }
+
+    state->FixedBufferPool_type = fixed_buffer_pool_register(mod);
+    if (state->FixedBufferPool_type == NULL) {
+        return -1;
+    }
+
+    state->LeasedBuffer_type = leased_buffer_register(mod);
+    if (state->LeasedBuffer_type == NULL) {
+        return -1;
+    }
+
     state->Task_type = task_register(mod);
     if (state->Task_type == NULL) {
         return -1;
     }
 
+    state->Channel_type = channel_register(mod);
+    if (state->Channel_type == NULL) {
+        return -1;
+    }
+
+    state->Dispatcher_type = dispatcher_register(mod);
+    if (state->Dispatcher_type == NULL) {
+        return -1;
+    }
+
     state->Operation_type = operation_register(mod);
     if (state->Operation_type == NULL) {
         return -1;
     }
 
-    state->OperationWaiter_type = operation_waiter_register(mod);
-    if (state->OperationWaiter_type == NULL) {
+    state->MultishotOperation_type = multishot_operation_register(mod);
+    if (state->MultishotOperation_type == NULL) {
+        return -1;
+    }
+
+    state->ChainOperation_type = chain_operation_register(mod);
+    if (state->ChainOperation_type == NULL) {
+        return -1;
+    }
+
+    state->RelayOperation_type = relay_operation_register(mod);
+    if (state->RelayOperation_type == NULL) {
         return -1;
     }
 
@@ -131,6 +225,16 @@ static int module_exec(PyObject *mod) {
         return -1;
     }
 
+    state->MsgRingOperation_type = msg_ring_operation_register(mod);
+    if (state->MsgRingOperation_type == NULL) {
+        return -1;
+    }
+
+    state->SleepOperation_type = sleep_operation_register(mod);
+    if (state->SleepOperation_type == NULL) {
+        return -1;
+    }
+
     state->SocketOperation_type = socket_operation_register(mod);
     if (state->SocketOperation_type == NULL) {
         return -1;
@@ -151,6 +255,31 @@ static int module_exec(PyObject *mod) {
         return -1;
     }
 
+    state->ReadIntoOperation_type = readinto_operation_register(mod);
+    if (state->ReadIntoOperation_type == NULL) {
+        return -1;
+    }
+
+    state->ReadvOperation_type = readv_operation_register(mod);
+    if (state->ReadvOperation_type == NULL) {
+        return -1;
+    }
+
+    state->ReadFixedOperation_type = read_fixed_operation_register(mod);
+    if (state->ReadFixedOperation_type == NULL) {
+        return -1;
+    }
+
+    state->WritevOperation_type = writev_operation_register(mod);
+    if (state->WritevOperation_type == NULL) {
+        return -1;
+    }
+
+    state->WriteFixedOperation_type = write_fixed_operation_register(mod);
+    if (state->WriteFixedOperation_type == NULL) {
+        return -1;
+    }
+
     state->CloseOperation_type = close_operation_register(mod);
     if (state->CloseOperation_type == NULL) {
         return -1;
@@ -201,6 +330,11 @@ static int module_exec(PyObject *mod) {
         return -1;
     }
 
+    state->AcceptMultishotOperation_type = accept_multishot_operation_register(mod);
+    if (state->AcceptMultishotOperation_type == NULL) {
+        return -1;
+    }
+
     state->BindOperation_type = bind_operation_register(mod);
     if (state->BindOperation_type == NULL) {
         return -1;
@@ -216,11 +350,56 @@ static int module_exec(PyObject *mod) {
         return -1;
     }
 
+    state->SendmsgOperation_type = sendmsg_operation_register(mod);
+    if (state->SendmsgOperation_type == NULL) {
+        return -1;
+    }
+
+    state->SendZcOperation_type = send_zc_operation_register(mod);
+    if (state->SendZcOperation_type == NULL) {
+        return -1;
+    }
+
+    state->SendfileOperation_type = sendfile_operation_register(mod);
+    if (state->SendfileOperation_type == NULL) {
+        return -1;
+    }
+
     state->RecvOperation_type = recv_operation_register(mod);
     if (state->RecvOperation_type == NULL) {
         return -1;
     }
 
+    state->RecvIntoOperation_type = recv_into_operation_register(mod);
+    if (state->RecvIntoOperation_type == NULL) {
+        return -1;
+    }
+
+    state->RecvmsgOperation_type = recvmsg_operation_register(mod);
+    if (state->RecvmsgOperation_type == NULL) {
+        return -1;
+    }
+
+    state->RecvBufferOperation_type = recv_buffer_operation_register(mod);
+    if (state->RecvBufferOperation_type == NULL) {
+        return -1;
+    }
+
+    state->RecvMultishotOperation_type = recv_multishot_operation_register(mod);
+    if (state->RecvMultishotOperation_type == NULL) {
+        return -1;
+    }
+
+    state->SpliceOperation_type = splice_operation_register(mod);
+    if (state->SpliceOperation_type == NULL) {
+        return -1;
+    }
+
+    state->TeeOperation_type = tee_operation_register(mod);
+    if (state->TeeOperation_type == NULL) {
+        return -1;
+    }
+
     state->StatxResult_type = statx_result_register(mod);
     if (state->StatxResult_type == NULL) {
         return -1;
@@ -253,10 +432,26 @@ static int module_exec(PyObject *mod) {
     return 0;
 }
 
+PyDoc_STRVAR(g_spawn_doc, "Runs a coroutine as a new task and returns an awaitable handle to it.");
+PyDoc_STRVAR(g_chain_doc, "Links operations into a chain which the kernel runs in order.");
+PyDoc_STRVAR(g_freelist_stats_doc, "Returns hit and miss counters of the Operation freelist.");
+PyDoc_STRVAR(g_timeout_doc, "Attaches a deadline in seconds to an operation before it is awaited.");
 PyDoc_STRVAR(g_nop_doc, "Asynchronous nop operation on the io_uring.");
+PyDoc_STRVAR(g_channel_doc, "Creates a channel that receives messages on the current runtime.");
+PyDoc_STRVAR(g_msg_ring_doc, "Posts a 32-bit message into the ring of the runtime that owns a channel.");
+PyDoc_STRVAR(g_send_fd_doc, "Installs a direct descriptor into the file table of the runtime that owns a channel.");
+PyDoc_STRVAR(g_dispatcher_doc, "Creates a dispatcher that spreads descriptor handoffs over channels.");
+PyDoc_STRVAR(g_sleep_doc, "Suspends the current task for the given number of seconds.");
+PyDoc_STRVAR(g_sleep_until_doc, "Suspends the current task until a deadline on the time.monotonic() clock.");
 PyDoc_STRVAR(g_socket_doc, "Asynchronous socket(2) operation on the io_uring.");
 PyDoc_STRVAR(g_read_doc, "Asynchronous read(2) operation on the io_uring.");
 PyDoc_STRVAR(g_write_doc, "Asynchronous write(2) operation on the io_uring.");
+PyDoc_STRVAR(g_readinto_doc, "Asynchronous read(2) operation into a caller-supplied writable buffer.");
+PyDoc_STRVAR(g_readv_doc, "Asynchronous readv(2) operation scattering into a sequence of writable buffers.");
+PyDoc_STRVAR(g_read_fixed_doc, "Asynchronous read(2) operation into a registered fixed buffer.");
+PyDoc_STRVAR(g_writev_doc, "Asynchronous writev(2) operation gathering from a sequence of buffers.");
+PyDoc_STRVAR(g_write_fixed_doc, "Asynchronous write(2) operation from a registered fixed buffer.");
+PyDoc_STRVAR(g_lease_fixed_doc, "Leases a slot from the runtime's registered fixed buffers.");
 PyDoc_STRVAR(g_close_doc, "Asynchronous close(2) operation on the io_uring.");
 PyDoc_STRVAR(g_openat_doc, "Asynchronous openat(2) operation on the io_uring.");
 PyDoc_STRVAR(g_cancel_fd_doc, "Asynchronously cancels all operations on a fd.");
@@ -269,28 +464,57 @@ PyDoc_STRVAR(g_linkat_doc, "Asynchronous linkat(2) operationg on the io_uring.")
 PyDoc_STRVAR(g_unlinkat_doc, "Asynchronous unlinkat(2) operationg on the io_uring.");
 PyDoc_STRVAR(g_symlinkat_doc, "Asynchronous symlinkat(2) operationg on the io_uring.");
 PyDoc_STRVAR(g_accept_doc, "Asynchronous accept(2) operation on the io_uring.");
+PyDoc_STRVAR(g_accept_multishot_doc, "Multishot accept(2) operation on the io_uring, consumed with async for.");
 PyDoc_STRVAR(g_bind_doc, "Asynchronous bind(2) operation on the io_uring.");
 PyDoc_STRVAR(g_listen_doc, "Asynchronous listen(2) operation on the io_uring.");
 PyDoc_STRVAR(g_send_doc, "Asynchronous send(2) operation on the io_uring.");
+PyDoc_STRVAR(g_sendmsg_doc, "Asynchronous sendmsg(2) operation gathering from a sequence of buffers.");
+PyDoc_STRVAR(g_send_zc_doc, "Asynchronous zero-copy send(2) operation on the io_uring.");
+PyDoc_STRVAR(g_sendfile_doc, "Streams a range of a file into a socket without copying it through userspace.");
 PyDoc_STRVAR(g_recv_doc, "Asynchronous recv(2) operation on the io_uring.");
+PyDoc_STRVAR(g_recv_into_doc, "Asynchronous recv(2) operation into a caller-supplied writable buffer.");
+PyDoc_STRVAR(g_recvmsg_doc, "Asynchronous recvmsg(2) operation scattering into a sequence of writable buffers.");
+PyDoc_STRVAR(g_recv_buffer_doc, "Asynchronous recv(2) operation into a buffer from the provided buffer ring.");
+PyDoc_STRVAR(g_recv_multishot_doc, "Multishot recv(2) operation with provided buffers, consumed with async for.");
+PyDoc_STRVAR(g_splice_doc, "Asynchronous splice(2) operation on the io_uring.");
+PyDoc_STRVAR(g_tee_doc, "Asynchronous tee(2) operation on the io_uring.");
+PyDoc_STRVAR(g_relay_doc, "Pumps data between two descriptors in both directions until end of file.");
 PyDoc_STRVAR(g_statx_doc, "Asynchronous statx(2) operation on the io_uring.");
 PyDoc_STRVAR(g_getsockopt_doc, "Asynchronous getsockopt(2) operation on the io_uring.");
 PyDoc_STRVAR(g_setsockopt_doc, "Asynchronous setsockopt(2) operation on the io_uring.");
 
 PyDoc_STRVAR(g_run_doc, "Drives a given coroutine to completion.\n\n"
                         "This is the entrypoint to the boros runtime.");
+PyDoc_STRVAR(g_shutdown_doc, "Destroys the runtime that a persistent run kept on the current thread.");
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wcast-function-type"
 static PyMethodDef g_module_methods[] = {
+    {"spawn", (PyCFunction)task_spawn, METH_FASTCALL, g_spawn_doc},
     {"nop", (PyCFunction)nop_operation_create, METH_O, g_nop_doc},
+    {"channel", (PyCFunction)channel_create, METH_NOARGS, g_channel_doc},
+    {"msg_ring", (PyCFunction)msg_ring_operation_create, METH_FASTCALL, g_msg_ring_doc},
+    {"send_fd", (PyCFunction)msg_ring_fd_operation_create, METH_FASTCALL, g_send_fd_doc},
+    {"dispatcher", (PyCFunction)dispatcher_create, METH_FASTCALL, g_dispatcher_doc},
+    {"sleep", (PyCFunction)sleep_operation_create, METH_O, g_sleep_doc},
+    {"sleep_until", (PyCFunction)sleep_until_operation_create, METH_O, g_sleep_until_doc},
+    {"chain", (PyCFunction)chain_operation_create, METH_FASTCALL, g_chain_doc},
+    {"timeout", (PyCFunction)operation_with_timeout, METH_FASTCALL, g_timeout_doc},
+    {"freelist_stats", (PyCFunction)operation_freelist_stats, METH_NOARGS, g_freelist_stats_doc},
     {"socket", (PyCFunction)socket_operation_create, METH_FASTCALL, g_socket_doc},
     {"run", (PyCFunction)event_loop_run, METH_FASTCALL, g_run_doc},
+    {"shutdown", (PyCFunction)runtime_shutdown, METH_NOARGS, g_shutdown_doc},
     {"openat", (PyCFunction)openat_operation_create, METH_FASTCALL, g_openat_doc},
     {"read", (PyCFunction)read_operation_create, METH_FASTCALL, g_read_doc},
     {"write", (PyCFunction)write_operation_create, METH_FASTCALL, g_write_doc},
+    {"readinto", (PyCFunction)readinto_operation_create, METH_FASTCALL, g_readinto_doc},
+    {"readv", (PyCFunction)readv_operation_create, METH_FASTCALL, g_readv_doc},
+    {"read_fixed", (PyCFunction)read_fixed_operation_create, METH_FASTCALL, g_read_fixed_doc},
+    {"writev", (PyCFunction)writev_operation_create, METH_FASTCALL, g_writev_doc},
+    {"write_fixed", (PyCFunction)write_fixed_operation_create, METH_FASTCALL, g_write_fixed_doc},
+    {"lease_fixed", (PyCFunction)fixed_buffer_lease, METH_NOARGS, g_lease_fixed_doc},
     {"close", (PyCFunction)close_operation_create, METH_FASTCALL, g_close_doc},
-    {"cancel_fd", (PyCFunction)cancel_operation_create_fd, METH_O, g_cancel_fd_doc},
+    {"cancel_fd", (PyCFunction)cancel_operation_create_fd, METH_FASTCALL, g_cancel_fd_doc},
     {"cancel_op", (PyCFunction)cancel_operation_create_op, METH_O, g_cancel_op_doc},
     {"connect", (PyCFunction)connect_operation_create, METH_FASTCALL, g_connect_doc},
     {"mkdirat", (PyCFunction)mkdirat_operation_create, METH_FASTCALL, g_mkdirat_doc},
@@ -300,10 +524,21 @@ static PyMethodDef g_module_methods[] = {
     {"unlinkat", (PyCFunction)unlinkat_operation_create, METH_FASTCALL, g_unlinkat_doc},
     {"symlinkat", (PyCFunction)symlinkat_operation_create, METH_FASTCALL, g_symlinkat_doc},
     {"accept", (PyCFunction)accept_operation_create, METH_FASTCALL, g_accept_doc},
+    {"accept_multishot", (PyCFunction)accept_multishot_operation_create, METH_FASTCALL, g_accept_multishot_doc},
     {"bind", (PyCFunction)bind_operation_create, METH_FASTCALL, g_bind_doc},
     {"listen", (PyCFunction)listen_operation_create, METH_FASTCALL, g_listen_doc},
     {"send", (PyCFunction)send_operation_create, METH_FASTCALL, g_send_doc},
+    {"sendmsg", (PyCFunction)sendmsg_operation_create, METH_FASTCALL, g_sendmsg_doc},
+    {"send_zc", (PyCFunction)send_zc_operation_create, METH_FASTCALL, g_send_zc_doc},
+    {"sendfile", (PyCFunction)sendfile_operation_create, METH_FASTCALL, g_sendfile_doc},
     {"recv", (PyCFunction)recv_operation_create, METH_FASTCALL, g_recv_doc},
+    {"recv_into", (PyCFunction)recv_into_operation_create, METH_FASTCALL, g_recv_into_doc},
+    {"recvmsg", (PyCFunction)recvmsg_operation_create, METH_FASTCALL, g_recvmsg_doc},
+    {"recv_buffer", (PyCFunction)recv_buffer_operation_create, METH_FASTCALL, g_recv_buffer_doc},
+    {"recv_multishot", (PyCFunction)recv_multishot_operation_create, METH_FASTCALL, g_recv_multishot_doc},
+    {"splice", (PyCFunction)splice_operation_create, METH_FASTCALL, g_splice_doc},
+    {"tee", (PyCFunction)tee_operation_create, METH_FASTCALL, g_tee_doc},
+    {"relay", (PyCFunction)relay_operation_create, METH_FASTCALL, g_relay_doc},
     {"statx", (PyCFunction)statx_operation_create, METH_FASTCALL, g_statx_doc},
     {"getsockopt", (PyCFunction)getsockopt_operation_create, METH_FASTCALL, g_getsockopt_doc},
     {"setsockopt", (PyCFunction)setsockopt_operation_create, METH_FASTCALL, g_setsockopt_doc},
@@ -314,6 +549,9 @@ static PyMethodDef g_module_methods[] = {
 static PyModuleDef_Slot g_module_slots[] = {
     {Py_mod_exec, module_exec},
     {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#ifdef Py_GIL_DISABLED
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
     {0, NULL},
 };
 
@@ -7,17 +7,33 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#include "op/base.h"
+
 typedef struct _ImplState {
     /* Python type objects that belong to this module. */
     PyTypeObject *RunConfig_type;
+    PyTypeObject *BufferRing_type;
+    PyTypeObject *FixedBufferPool_type;
+    PyTypeObject *LeasedBuffer_type;
     PyTypeObject *Task_type;
+    PyTypeObject *Channel_type;
+    PyTypeObject *Dispatcher_type;
     PyTypeObject *Operation_type;
-    PyTypeObject *OperationWaiter_type;
+    PyTypeObject *MultishotOperation_type;
+    PyTypeObject *ChainOperation_type;
+    PyTypeObject *RelayOperation_type;
     PyTypeObject *NopOperation_type;
+    PyTypeObject *MsgRingOperation_type;
+    PyTypeObject *SleepOperation_type;
     PyTypeObject *SocketOperation_type;
     PyTypeObject *OpenAtOperation_type;
     PyTypeObject *ReadOperation_type;
     PyTypeObject *WriteOperation_type;
+    PyTypeObject *ReadIntoOperation_type;
+    PyTypeObject *ReadvOperation_type;
+    PyTypeObject *ReadFixedOperation_type;
+    PyTypeObject *WritevOperation_type;
+    PyTypeObject *WriteFixedOperation_type;
     PyTypeObject *CloseOperation_type;
     PyTypeObject *CancelOperation_type;
     PyTypeObject *ConnectOperation_type;
@@ -28,15 +44,31 @@ typedef struct _ImplState {
     PyTypeObject *UnlinkAtOperation_type;
     PyTypeObject *SymlinkAtOperation_type;
     PyTypeObject *AcceptOperation_type;
+    PyTypeObject *AcceptMultishotOperation_type;
     PyTypeObject *BindOperation_type;
     PyTypeObject *ListenOperation_type;
     PyTypeObject *SendOperation_type;
+    PyTypeObject *SendmsgOperation_type;
+    PyTypeObject *SendZcOperation_type;
+    PyTypeObject *SendfileOperation_type;
     PyTypeObject *RecvOperation_type;
+    PyTypeObject *RecvIntoOperation_type;
+    PyTypeObject *RecvmsgOperation_type;
+    PyTypeObject *RecvBufferOperation_type;
+    PyTypeObject *RecvMultishotOperation_type;
+    PyTypeObject *SpliceOperation_type;
+    PyTypeObject *TeeOperation_type;
     PyTypeObject *StatxResult_type;
     PyTypeObject *StatxOperation_type;
     PyTypeObject *GetsockoptOperation_type;
     PyTypeObject *SetsockoptOperation_type;
 
+    /* Messages for OSErrors built from failed completions. */
+    ErrnoCache errno_cache;
+
+    /* Recycled memory of Operation objects. */
+    OperationFreelist freelist;
+
     /* The thread-local runtime handle. */
     Py_tss_t *local_handle;
 } ImplState;
@@ -6,11 +6,19 @@
 #include "module.h"
 #include "util/sockaddr.h"
 
+/* AcceptOperation implementation */
+
 static void accept_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     AcceptOperation *op = (AcceptOperation *)self;
 
+    struct sockaddr *addr = (struct sockaddr *)&op->addr;
+
     op->addrlen = sizeof(op->addr);
-    io_uring_prep_accept(sqe, op->base.scratch, (struct sockaddr *)&op->addr, &op->addrlen, op->flags);
+    if (op->direct) {
+        io_uring_prep_accept_direct(sqe, op->base.scratch, addr, &op->addrlen, op->flags, IORING_FILE_INDEX_ALLOC);
+    } else {
+        io_uring_prep_accept(sqe, op->base.scratch, addr, &op->addrlen, op->flags);
+    }
 }
 
 static void accept_complete(PyObject *self, struct io_uring_cqe *cqe) {
@@ -47,8 +55,8 @@ PyObject *accept_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 2) {
-        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+    if (nargs != 2 && nargs != 3) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 or 3 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -62,11 +70,17 @@ PyObject *accept_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 3 && !python_parse_bool(&direct, args[2])) {
+        return NULL;
+    }
+
     AcceptOperation *op = (AcceptOperation *)operation_alloc(state->AcceptOperation_type, state);
     if (op != NULL) {
         op->base.vtable  = &g_accept_operation_vtable;
         op->base.scratch = fd;
         op->flags        = flags;
+        op->direct       = direct;
     }
 
     return (PyObject *)op;
@@ -88,3 +102,117 @@ PyTypeObject *accept_operation_register(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_accept_operation_spec, (PyObject *)state->Operation_type);
 }
+
+/* AcceptMultishotOperation implementation */
+
+static void accept_multishot_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    AcceptMultishotOperation *op = (AcceptMultishotOperation *)self;
+
+    /*
+     * The kernel would write the peer address of every connection into
+     * the same buffer, so by the time we reap a batch of completions it
+     * only holds the last one. Query addresses on completion instead,
+     * if the caller asked for them.
+     */
+    io_uring_prep_multishot_accept(sqe, op->base.base.scratch, NULL, NULL, op->flags);
+}
+
+static void accept_multishot_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    AcceptMultishotOperation *accept = (AcceptMultishotOperation *)self;
+    MultishotOperation *op           = &accept->base;
+    struct sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    PyObject *addrobj;
+
+    if (cqe->res < 0) {
+        multishot_operation_push_errno(op, -cqe->res);
+        return;
+    }
+
+    /*
+     * Looking up the address costs a system call per connection while
+     * reaping. The peer may already be gone, but the fd is still ours.
+     */
+    if (!accept->peername) {
+        addrobj = Py_NewRef(Py_None);
+    } else if (getpeername(cqe->res, (struct sockaddr *)&addr, &addrlen) == 0) {
+        addrobj = format_sockaddr((const struct sockaddr *)&addr, addrlen);
+        if (addrobj == NULL) {
+            PyErr_Clear();
+            addrobj = Py_NewRef(Py_None);
+        }
+    } else {
+        addrobj = Py_NewRef(Py_None);
+    }
+
+    PyObject *fd = PyLong_FromLong(cqe->res);
+    if (fd == NULL) {
+        Py_DECREF(addrobj);
+        multishot_operation_push(op, NULL);
+        return;
+    }
+
+    PyObject *result = PyTuple_Pack(2, fd, addrobj);
+    Py_DECREF(fd);
+    Py_DECREF(addrobj);
+    multishot_operation_push(op, result);
+}
+
+static OperationVTable g_accept_multishot_operation_vtable = {
+    .prepare  = accept_multishot_prepare,
+    .complete = accept_multishot_complete,
+};
+
+PyObject *accept_multishot_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2 && nargs != 3) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 or 3 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[1])) {
+        return NULL;
+    }
+
+    bool peername = false;
+    if (nargs == 3 && !python_parse_bool(&peername, args[2])) {
+        return NULL;
+    }
+
+    AcceptMultishotOperation *op =
+        (AcceptMultishotOperation *)multishot_operation_alloc(state->AcceptMultishotOperation_type, state);
+    if (op != NULL) {
+        op->base.base.vtable  = &g_accept_multishot_operation_vtable;
+        op->base.base.scratch = fd;
+        op->flags             = flags;
+        op->peername          = peername;
+    }
+
+    return (PyObject *)op;
+}
+
+static PyType_Slot g_accept_multishot_operation_slots[] = {
+    {0, NULL},
+};
+
+static PyType_Spec g_accept_multishot_operation_spec = {
+    .name      = "_impl._AcceptMultishotOperation",
+    .basicsize = sizeof(AcceptMultishotOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_accept_multishot_operation_slots,
+};
+
+PyTypeObject *accept_multishot_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_accept_multishot_operation_spec,
+                                                    (PyObject *)state->MultishotOperation_type);
+}
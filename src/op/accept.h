@@ -4,6 +4,7 @@
 #pragma once
 
 #include "op/base.h"
+#include "op/multishot.h"
 
 typedef struct {
     /* fd is stored in base.scratch */
@@ -11,7 +12,19 @@ typedef struct {
     struct sockaddr_storage addr;
     socklen_t addrlen;
     int flags;
+    bool direct;
 } AcceptOperation;
 
+typedef struct {
+    /* fd is stored in base.base.scratch */
+    MultishotOperation base;
+    int flags;
+    /* Whether to look up the peer address of every connection. */
+    bool peername;
+} AcceptMultishotOperation;
+
 PyObject *accept_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 PyTypeObject *accept_operation_register(PyObject *mod);
+
+PyObject *accept_multishot_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *accept_multishot_operation_register(PyObject *mod);
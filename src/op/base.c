@@ -3,23 +3,186 @@
 
 #include "op/base.h"
 
+#include <math.h>
+#include <string.h>
+
 #include "module.h"
 #include "util/python.h"
 
+/* OperationFreelist implementation */
+
+typedef struct _FreeOperation {
+    struct _FreeOperation *next;
+} FreeOperation;
+
+static inline bool freelist_class(PyTypeObject *tp, size_t *out) {
+    size_t size = (size_t)tp->tp_basicsize;
+
+    /*
+     * Variable-sized objects and odd sizes are never cached. Neither are
+     * objects tracked by the GC, which only the interpreter may allocate.
+     */
+    if (PyType_IS_GC(tp) || tp->tp_itemsize != 0 || size % sizeof(void *) != 0) {
+        return false;
+    }
+
+    size /= sizeof(void *);
+    if (size >= OPERATION_FREELIST_CLASSES) {
+        return false;
+    }
+
+    *out = size;
+    return true;
+}
+
+static Operation *freelist_pop(OperationFreelist *self, PyTypeObject *tp) {
+#ifdef Py_GIL_DISABLED
+    /* The freelist is shared state, which requires the GIL. */
+    (void)self;
+    (void)tp;
+    return NULL;
+#else
+    size_t cls;
+    if (!freelist_class(tp, &cls) || self->heads[cls] == NULL) {
+        ++self->misses;
+        return NULL;
+    }
+
+    FreeOperation *entry = self->heads[cls];
+    self->heads[cls]     = entry->next;
+    --self->counts[cls];
+    ++self->hits;
+
+    /*
+     * The memory came from PyObject_Malloc, so it can be initialized
+     * the same way PyObject_New does it for any other plain object.
+     */
+    PyObject *ob = (PyObject *)entry;
+    memset(ob, 0, tp->tp_basicsize);
+    PyObject_Init(ob, tp);
+    return (Operation *)ob;
+#endif
+}
+
+static bool freelist_push(OperationFreelist *self, PyObject *ob) {
+#ifdef Py_GIL_DISABLED
+    (void)self;
+    (void)ob;
+    return false;
+#else
+    size_t cls;
+    if (!freelist_class(Py_TYPE(ob), &cls) || self->counts[cls] >= OPERATION_FREELIST_CAPACITY) {
+        return false;
+    }
+
+    FreeOperation *entry = (FreeOperation *)ob;
+    entry->next          = self->heads[cls];
+    self->heads[cls]     = entry;
+    ++self->counts[cls];
+    return true;
+#endif
+}
+
+void operation_freelist_clear(OperationFreelist *self) {
+    for (size_t cls = 0; cls < OPERATION_FREELIST_CLASSES; ++cls) {
+        FreeOperation *entry = self->heads[cls];
+        while (entry != NULL) {
+            FreeOperation *next = entry->next;
+            PyObject_Free(entry);
+            entry = next;
+        }
+
+        self->heads[cls]  = NULL;
+        self->counts[cls] = 0;
+    }
+}
+
+PyObject *operation_freelist_stats(PyObject *mod, PyObject *args) {
+    (void)args;
+    ImplState *state = PyModule_GetState(mod);
+
+    unsigned long long cached = 0;
+    for (size_t cls = 0; cls < OPERATION_FREELIST_CLASSES; ++cls) {
+        cached += state->freelist.counts[cls];
+    }
+
+    return Py_BuildValue("{sKsKsK}", "hits", state->freelist.hits, "misses", state->freelist.misses, "cached",
+                         cached);
+}
+
 /* Operation implementation */
 
 Operation *operation_alloc(PyTypeObject *tp, ImplState *state) {
-    Operation *op = (Operation *)python_alloc(tp);
+    Operation *op = freelist_pop(&state->freelist, tp);
+    if (op == NULL) {
+        op = (Operation *)python_alloc(tp);
+    }
+
     if (op != NULL) {
-        op->module_state = state;
-        op->state        = State_Pending;
-        op->awaiter      = NULL;
+        op->module_state  = state;
+        op->state         = State_Pending;
+        op->awaiter       = NULL;
+        op->inflight      = false;
+        op->sqe_flags     = 0;
+        op->parent        = NULL;
+        op->timeout_state  = Timeout_None;
+        op->deferred_flags = 0;
         outcome_init(&op->outcome);
     }
 
     return op;
 }
 
+PyObject *operation_with_timeout(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    /*
+     * The timeout cancels the operation it is linked to. For multishot
+     * operations, chains and relays or transfers which submit several
+     * times, that would not be a per-operation deadline. Sleeps do not
+     * go through the kernel at all.
+     */
+    PyObject *ob = args[0];
+    if (PyObject_TypeCheck(ob, state->Operation_type) == 0 ||
+        PyObject_TypeCheck(ob, state->MultishotOperation_type) != 0 ||
+        PyObject_TypeCheck(ob, state->ChainOperation_type) != 0 ||
+        PyObject_TypeCheck(ob, state->RelayOperation_type) != 0 ||
+        PyObject_TypeCheck(ob, state->SendfileOperation_type) != 0 ||
+        PyObject_TypeCheck(ob, state->SleepOperation_type) != 0) {
+        PyErr_Format(PyExc_TypeError, "Cannot attach a timeout to object of type %.500s", Py_TYPE(ob)->tp_name);
+        return NULL;
+    }
+
+    Operation *op = (Operation *)ob;
+    if (op->state != State_Pending || op->inflight) {
+        PyErr_SetString(PyExc_RuntimeError, "Cannot attach a timeout to an operation that was already awaited");
+        return NULL;
+    }
+
+    double seconds = PyFloat_AsDouble(args[1]);
+    if (seconds == -1.0 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (!isfinite(seconds) || seconds < 0.0 || seconds >= (double)LLONG_MAX) {
+        PyErr_SetString(PyExc_ValueError, "Timeout must be a non-negative, finite number of seconds");
+        return NULL;
+    }
+
+    long long whole     = (long long)seconds;
+    op->timeout.tv_sec  = whole;
+    op->timeout.tv_nsec = (long long)((seconds - (double)whole) * 1e9);
+    op->timeout_state   = Timeout_Pending;
+
+    return Py_NewRef(ob);
+}
+
 int operation_traverse(Operation *self, visitproc visit, void *arg) {
     Py_VISIT(self->awaiter);
 
@@ -37,59 +200,34 @@ int operation_clear(Operation *self) {
     return 0;
 }
 
-static int operation_traverse_impl(PyObject *self, visitproc visit, void *arg) {
-    Py_VISIT(Py_TYPE(self));
-    return operation_traverse((Operation *)self, visit, arg);
-}
+static void operation_dealloc(PyObject *self) {
+    Operation *op    = (Operation *)self;
+    PyTypeObject *tp = Py_TYPE(self);
 
-static int operation_clear_impl(PyObject *self) {
-    return operation_clear((Operation *)self);
-}
-
-static PyObject *operation_await(PyObject *self) {
-    Operation *op = (Operation *)self;
+    if (PyType_IS_GC(tp)) {
+        PyObject_GC_UnTrack(self);
+    }
 
-    /* Guard against attempts to build subclasses without a vtable. */
-    if (op->vtable == NULL) {
-        PyErr_SetString(PyExc_TypeError, "Invalid Operation subclass detected");
-        return NULL;
+    inquiry tp_clear = tp->tp_clear;
+    if (tp_clear != NULL && tp_clear(self) < 0) {
+        PyErr_WriteUnraisable(self);
     }
 
-    OperationWaiter *waiter = (OperationWaiter *)python_alloc(op->module_state->OperationWaiter_type);
-    if (waiter != NULL) {
-        waiter->op = Py_NewRef(self);
+    /* Keep the memory around for the next Operation of this size. */
+    if (!freelist_push(&op->module_state->freelist, self)) {
+        tp->tp_free(self);
     }
 
-    return (PyObject *)waiter;
+    Py_DECREF(tp);
 }
 
-// clang-format off
-static PyType_Slot g_operation_slots[] = {
-    {Py_tp_dealloc, python_tp_dealloc},
-    {Py_tp_traverse, operation_traverse_impl},
-    {Py_tp_clear, operation_clear_impl},
-    {Py_am_await, operation_await},
-    {0, NULL},
-};
-// clang-format on
-
-static PyType_Spec g_operation_spec = {
-    .name      = "_impl._Operation",
-    .basicsize = sizeof(Operation),
-    .itemsize  = 0,
-    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_BASETYPE,
-    .slots     = g_operation_slots,
-};
-
-PyTypeObject *operation_register(PyObject *mod) {
-    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_operation_spec, NULL);
+static int operation_clear_impl(PyObject *self) {
+    return operation_clear((Operation *)self);
 }
 
-/* OperationWaiter implementation */
-
-static PyObject *operation_waiter_iternext(PyObject *self) {
-    OperationWaiter *waiter = (OperationWaiter *)self;
-    Operation *op           = (Operation *)waiter->op;
+static PySendResult operation_send(PyObject *self, PyObject *arg, PyObject **presult) {
+    Operation *op = (Operation *)self;
+    (void)arg;
 
     switch (op->state) {
     case State_Pending:
@@ -105,7 +243,8 @@ static PyObject *operation_waiter_iternext(PyObject *self) {
          */
         assert(op->awaiter == NULL);
         op->state = State_Blocked;
-        return Py_NewRef(waiter->op);
+        *presult  = Py_NewRef(self);
+        return PYGEN_NEXT;
 
     case State_Blocked:
         /*
@@ -118,7 +257,8 @@ static PyObject *operation_waiter_iternext(PyObject *self) {
          * actually awaiting it. This is unsupported behavior.
          */
         PyErr_SetString(PyExc_RuntimeError, "Operation was not properly awaited");
-        return NULL;
+        *presult = NULL;
+        return PYGEN_ERROR;
 
     case State_Ready:
         /*
@@ -131,61 +271,71 @@ static PyObject *operation_waiter_iternext(PyObject *self) {
          */
         if (outcome_empty(&op->outcome)) {
             PyErr_SetString(PyExc_RuntimeError, "Operation result was already consumed");
-            return NULL;
+            *presult = NULL;
+            return PYGEN_ERROR;
         }
 
-        PyObject *res = outcome_unwrap(&op->outcome);
-        if (res != NULL) {
-            PyObject *args[2] = {NULL, res};
-            size_t nargsf     = 1 | PY_VECTORCALL_ARGUMENTS_OFFSET;
+        *presult = outcome_unwrap(&op->outcome, &op->module_state->errno_cache);
+        return *presult != NULL ? PYGEN_RETURN : PYGEN_ERROR;
 
-            PyObject *exc = PyObject_Vectorcall(PyExc_StopIteration, args + 1, nargsf, NULL);
-            Py_DECREF(res);
-            if (exc != NULL) {
-                PyErr_SetRaisedException(exc);
-            }
-        }
+    default:
+        PyErr_SetString(PyExc_RuntimeError, "Corrupt operation state");
+        *presult = NULL;
+        return PYGEN_ERROR;
+    }
+}
 
-        return NULL;
+static PyObject *operation_iternext(PyObject *self) {
+    PyObject *res;
 
+    /*
+     * The interpreter resumes awaitables through tp_iternext, which
+     * has to report the result of the operation via StopIteration.
+     */
+    switch (operation_send(self, Py_None, &res)) {
+    case PYGEN_NEXT:
+        return res;
+    case PYGEN_RETURN:
+        python_stop_iteration(res);
+        return NULL;
     default:
-        PyErr_SetString(PyExc_RuntimeError, "Corrupt operation state");
         return NULL;
     }
 }
 
-static int operation_waiter_traverse(PyObject *self, visitproc visit, void *arg) {
-    OperationWaiter *waiter = (OperationWaiter *)self;
-    Py_VISIT(Py_TYPE(self));
-    Py_VISIT(waiter->op);
-    return 0;
-}
+static PyObject *operation_await(PyObject *self) {
+    Operation *op = (Operation *)self;
 
-static int operation_waiter_clear(PyObject *self) {
-    OperationWaiter *waiter = (OperationWaiter *)self;
-    Py_CLEAR(waiter->op);
-    return 0;
+    /* Guard against attempts to build subclasses without a vtable. */
+    if (op->vtable == NULL) {
+        PyErr_SetString(PyExc_TypeError, "Invalid Operation subclass detected");
+        return NULL;
+    }
+
+    /* Operations are their own iterators, so awaiting never allocates. */
+    return Py_NewRef(self);
 }
 
 // clang-format off
-static PyType_Slot g_operation_waiter_slots[] = {
-    {Py_tp_dealloc, python_tp_dealloc},
-    {Py_tp_traverse, operation_waiter_traverse},
-    {Py_tp_clear, operation_waiter_clear},
+static PyType_Slot g_operation_slots[] = {
+    {Py_tp_dealloc, operation_dealloc},
+    {Py_tp_clear, operation_clear_impl},
     {Py_tp_iter, PyObject_SelfIter},
-    {Py_tp_iternext, operation_waiter_iternext},
+    {Py_tp_iternext, operation_iternext},
+    {Py_am_await, operation_await},
+    {Py_am_send, operation_send},
     {0, NULL},
 };
 // clang-format on
 
-static PyType_Spec g_operation_waiter_spec = {
-    .name      = "_impl._OperationWaiter",
-    .basicsize = sizeof(OperationWaiter),
+static PyType_Spec g_operation_spec = {
+    .name      = "_impl._Operation",
+    .basicsize = sizeof(Operation),
     .itemsize  = 0,
-    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
-    .slots     = g_operation_waiter_slots,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_BASETYPE,
+    .slots     = g_operation_slots,
 };
 
-PyTypeObject *operation_waiter_register(PyObject *mod) {
-    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_operation_waiter_spec, NULL);
+PyTypeObject *operation_register(PyObject *mod) {
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_operation_spec, NULL);
 }
@@ -24,29 +24,77 @@ typedef struct {
     void (*complete)(PyObject *, struct io_uring_cqe *);
 } OperationVTable;
 
+/* Tracks the linked timeout of an Operation through its two completions. */
+typedef enum {
+    Timeout_None,
+    Timeout_Pending,
+    Timeout_Armed,
+    Timeout_Fired,
+    Timeout_Deferred,
+} TimeoutState;
+
 struct _ImplState;
 
 /* Represents the base state of I/O operations in the runtime. */
-typedef struct {
+typedef struct _Operation {
     PyObject_HEAD
     OperationVTable *vtable;
     struct _ImplState *module_state;
     Task *awaiter;
     OperationState state;
+    bool inflight;
+    /* Extra IOSQE_* flags for the submission, e.g. IOSQE_FIXED_FILE. */
+    unsigned char sqe_flags;
+    /* The chain this operation is linked into while in flight. */
+    struct _Operation *parent;
+    /* Relative deadline, submitted as IORING_OP_LINK_TIMEOUT. */
+    struct __kernel_timespec timeout;
+    TimeoutState timeout_state;
+    /* Flags of the completion held back while in Timeout_Deferred state. */
+    unsigned int deferred_flags;
     int scratch;
     Outcome outcome;
 } Operation;
 
-/* State machine for awaiting the completion of an Operation. */
+/*
+ * Caches the memory of dead Operations for reuse by the next one of the
+ * same size, which avoids an allocator round trip for every await.
+ * Objects are bucketed by their exact tp_basicsize in pointer units.
+ * Only types without GC support are cached, which are the operations
+ * that cannot be part of a reference cycle.
+ */
+#define OPERATION_FREELIST_CLASSES  64
+#define OPERATION_FREELIST_CAPACITY 32
+
 typedef struct {
-    PyObject_HEAD
-    PyObject *op;
-} OperationWaiter;
+    void *heads[OPERATION_FREELIST_CLASSES];
+    unsigned int counts[OPERATION_FREELIST_CLASSES];
+    unsigned long long hits;
+    unsigned long long misses;
+} OperationFreelist;
+
+/* Releases all memory cached in the freelist. */
+void operation_freelist_clear(OperationFreelist *freelist);
+
+/* Returns a dict with the hit and miss counters of the freelist. */
+PyObject *operation_freelist_stats(PyObject *mod, PyObject *args);
 
 Operation *operation_alloc(PyTypeObject *tp, struct _ImplState *state);
 
+/* Marks op as Ready and appends its awaiting task to the run queue. */
+static inline void operation_wake(TaskList *list, Operation *op) {
+    op->state = State_Ready;
+
+    if (op->awaiter != NULL) {
+        task_list_push_back(list, op->awaiter);
+        Py_CLEAR(op->awaiter);
+    }
+}
+
+/* Attaches a deadline to an operation which has not been submitted yet. */
+PyObject *operation_with_timeout(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
 int operation_traverse(Operation *self, visitproc visit, void *arg);
 int operation_clear(Operation *self);
 
 PyTypeObject *operation_register(PyObject *mod);
-PyTypeObject *operation_waiter_register(PyObject *mod);
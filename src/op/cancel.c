@@ -15,7 +15,7 @@ static void cancel_prepare(PyObject *self, struct io_uring_sqe *sqe) {
         io_uring_prep_cancel(sqe, op->target, 0);
     } else {
         /* Cancel all operations on the fd. */
-        io_uring_prep_cancel_fd(sqe, op->base.scratch, IORING_ASYNC_CANCEL_ALL);
+        io_uring_prep_cancel_fd(sqe, op->base.scratch, op->flags);
     }
 }
 
@@ -35,11 +35,22 @@ static OperationVTable g_cancel_operation_vtable = {
     .complete = cancel_complete,
 };
 
-PyObject *cancel_operation_create_fd(PyObject *mod, PyObject *arg) {
+PyObject *cancel_operation_create_fd(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
     ImplState *state = PyModule_GetState(mod);
 
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 1 && nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 1 or 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
     int fd;
-    if (!python_parse_int(&fd, arg)) {
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 2 && !python_parse_bool(&direct, args[1])) {
         return NULL;
     }
 
@@ -48,6 +59,7 @@ PyObject *cancel_operation_create_fd(PyObject *mod, PyObject *arg) {
         op->base.vtable  = &g_cancel_operation_vtable;
         op->target       = NULL;
         op->base.scratch = fd;
+        op->flags        = IORING_ASYNC_CANCEL_ALL | (direct ? IORING_ASYNC_CANCEL_FD_FIXED : 0);
     }
 
     return (PyObject *)op;
@@ -65,6 +77,7 @@ PyObject *cancel_operation_create_op(PyObject *mod, PyObject *arg) {
     if (op != NULL) {
         op->base.vtable = &g_cancel_operation_vtable;
         op->target      = (Operation *)Py_NewRef(arg);
+        op->flags       = 0;
     }
 
     return (PyObject *)op;
@@ -9,8 +9,9 @@ typedef struct {
     /* cancel fd is stored in base.scratch, if given */
     Operation base;
     Operation *target;
+    unsigned int flags;
 } CancelOperation;
 
-PyObject *cancel_operation_create_fd(PyObject *mod, PyObject *fd);
+PyObject *cancel_operation_create_fd(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 PyObject *cancel_operation_create_op(PyObject *mod, PyObject *op);
 PyTypeObject *cancel_operation_register(PyObject *mod);
@@ -0,0 +1,217 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/chain.h"
+
+#include "util/python.h"
+
+#include <assert.h>
+
+#include "module.h"
+
+static void chain_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    (void)self;
+    (void)sqe;
+
+    /* Chains are submitted via chain_operation_submit instead. */
+    Py_UNREACHABLE();
+}
+
+static void chain_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    (void)self;
+    (void)cqe;
+
+    /* Completions are posted for the individual links only. */
+    Py_UNREACHABLE();
+}
+
+static OperationVTable g_chain_operation_vtable = {
+    .prepare  = chain_prepare,
+    .complete = chain_complete,
+};
+
+PyObject *chain_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 1 && nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 1 or 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    bool hard = false;
+    if (nargs == 2 && !python_parse_bool(&hard, args[1])) {
+        return NULL;
+    }
+
+    PyObject *ops = PySequence_Tuple(args[0]);
+    if (ops == NULL) {
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(ops) == 0) {
+        PyErr_SetString(PyExc_ValueError, "Cannot create an empty chain");
+        Py_DECREF(ops);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(ops); ++i) {
+        PyObject *ob = PyTuple_GET_ITEM(ops, i);
+
+        /*
+         * Every link must produce exactly one completion, which rules
+         * out multishot operations, nested chains, relays and transfers
+         * which submit several times, and sleeps that never reach the
+         * kernel.
+         */
+        if (PyObject_TypeCheck(ob, state->Operation_type) == 0 ||
+            PyObject_TypeCheck(ob, state->MultishotOperation_type) != 0 ||
+            PyObject_TypeCheck(ob, state->ChainOperation_type) != 0 ||
+            PyObject_TypeCheck(ob, state->RelayOperation_type) != 0 ||
+            PyObject_TypeCheck(ob, state->SendfileOperation_type) != 0 ||
+            PyObject_TypeCheck(ob, state->SleepOperation_type) != 0) {
+            PyErr_Format(PyExc_TypeError, "Cannot chain object of type %.500s", Py_TYPE(ob)->tp_name);
+            Py_DECREF(ops);
+            return NULL;
+        }
+    }
+
+    ChainOperation *op = (ChainOperation *)operation_alloc(state->ChainOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable = &g_chain_operation_vtable;
+        op->ops         = ops;
+        op->remaining   = 0;
+        op->hard        = hard;
+    } else {
+        Py_DECREF(ops);
+    }
+
+    return (PyObject *)op;
+}
+
+static bool chain_validate_links(ChainOperation *self) {
+    Py_ssize_t n = PyTuple_GET_SIZE(self->ops);
+
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        Operation *link = (Operation *)PyTuple_GET_ITEM(self->ops, i);
+
+        if (link->vtable == NULL) {
+            PyErr_SetString(PyExc_TypeError, "Invalid Operation subclass detected");
+            return false;
+        }
+
+        if (link->state != State_Pending || link->inflight) {
+            PyErr_SetString(PyExc_RuntimeError, "Chained operations must not be awaited elsewhere");
+            return false;
+        }
+
+        for (Py_ssize_t j = 0; j < i; ++j) {
+            if (PyTuple_GET_ITEM(self->ops, j) == (PyObject *)link) {
+                PyErr_SetString(PyExc_RuntimeError, "Operation appears more than once in the chain");
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int chain_operation_submit(ChainOperation *self, Proactor *proactor) {
+    Py_ssize_t n      = PyTuple_GET_SIZE(self->ops);
+    unsigned nentries = 0;
+
+    if (!chain_validate_links(self)) {
+        return -1;
+    }
+
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        nentries += proactor_operation_size((Operation *)PyTuple_GET_ITEM(self->ops, i));
+    }
+
+    /*
+     * A link that ends a batch of submissions also ends the chain in
+     * the kernel. Make room for all of it in the queue upfront.
+     */
+    if (!proactor_reserve(proactor, nentries)) {
+        return -1;
+    }
+
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        Operation *link     = (Operation *)PyTuple_GET_ITEM(self->ops, i);
+        unsigned char flags = 0;
+
+        if (i < n - 1) {
+            flags = self->hard ? IOSQE_IO_HARDLINK : IOSQE_IO_LINK;
+        }
+
+        int res = proactor_push_operation(proactor, link, flags);
+        assert(res == 0);
+        (void)res;
+
+        /* The proactor holds a reference to each link while in flight. */
+        link->parent = &self->base;
+        link->state  = State_Blocked;
+        Py_INCREF(link);
+    }
+
+    self->remaining     = n;
+    self->base.inflight = true;
+    return 0;
+}
+
+bool chain_operation_finish_link(ChainOperation *self) {
+    assert(self->remaining > 0);
+    if (--self->remaining > 0) {
+        return false;
+    }
+
+    Py_ssize_t n     = PyTuple_GET_SIZE(self->ops);
+    PyObject *result = PyTuple_New(n);
+    if (result != NULL) {
+        /* Every link reports either its value or its exception. */
+        for (Py_ssize_t i = 0; i < n; ++i) {
+            Operation *link = (Operation *)PyTuple_GET_ITEM(self->ops, i);
+
+            PyObject *ob = outcome_take(&link->outcome, &self->base.module_state->errno_cache);
+            PyTuple_SET_ITEM(result, i, ob != NULL ? ob : Py_NewRef(Py_None));
+        }
+    }
+
+    outcome_capture(&self->base.outcome, result);
+    self->base.inflight = false;
+    return true;
+}
+
+static int chain_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    ChainOperation *op = (ChainOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->ops);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int chain_clear_impl(PyObject *self) {
+    ChainOperation *op = (ChainOperation *)self;
+
+    Py_CLEAR(op->ops);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_chain_operation_slots[] = {
+    {Py_tp_traverse, chain_traverse_impl},
+    {Py_tp_clear, chain_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_chain_operation_spec = {
+    .name      = "_impl._ChainOperation",
+    .basicsize = sizeof(ChainOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_chain_operation_slots,
+};
+
+PyTypeObject *chain_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_chain_operation_spec, (PyObject *)state->Operation_type);
+}
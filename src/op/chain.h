@@ -0,0 +1,32 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "driver/proactor.h"
+#include "op/base.h"
+
+/*
+ * A sequence of operations which are submitted back-to-back with
+ * IOSQE_IO_LINK, so the kernel runs them in order without a round
+ * trip to userspace in between. The chain is awaited as a whole.
+ */
+typedef struct {
+    Operation base;
+    PyObject *ops;
+    Py_ssize_t remaining;
+    bool hard;
+} ChainOperation;
+
+PyObject *chain_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
+/* Submits all operations in the chain as one linked sequence. */
+int chain_operation_submit(ChainOperation *self, Proactor *proactor);
+
+/*
+ * Records the completion of a linked operation. Returns true once the
+ * last link completed and the chain holds its results.
+ */
+bool chain_operation_finish_link(ChainOperation *self);
+
+PyTypeObject *chain_operation_register(PyObject *mod);
@@ -9,7 +9,11 @@
 
 static void close_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     CloseOperation *op = (CloseOperation *)self;
-    io_uring_prep_close(sqe, op->base.scratch);
+    if (op->direct) {
+        io_uring_prep_close_direct(sqe, op->base.scratch);
+    } else {
+        io_uring_prep_close(sqe, op->base.scratch);
+    }
 }
 
 static void close_complete(PyObject *self, struct io_uring_cqe *cqe) {
@@ -32,8 +36,8 @@ PyObject *close_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 1) {
-        PyErr_Format(PyExc_TypeError, "Expected 1 argument, got %zu instead", nargs);
+    if (nargs != 1 && nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 1 or 2 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -42,10 +46,16 @@ PyObject *close_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 2 && !python_parse_bool(&direct, args[1])) {
+        return NULL;
+    }
+
     CloseOperation *op = (CloseOperation *)operation_alloc(state->CloseOperation_type, state);
     if (op != NULL) {
         op->base.vtable  = &g_close_operation_vtable;
         op->base.scratch = fd;
+        op->direct       = direct;
     }
 
     return (PyObject *)op;
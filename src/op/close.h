@@ -8,6 +8,7 @@
 typedef struct {
     /* fd is stored in base.scratch */
     Operation base;
+    bool direct;
 } CloseOperation;
 
 PyObject *close_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
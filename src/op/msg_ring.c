@@ -0,0 +1,124 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/msg_ring.h"
+
+#include "util/python.h"
+
+#include "driver/proactor.h"
+#include "module.h"
+
+static void msg_ring_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    MsgRingOperation *op = (MsgRingOperation *)self;
+
+    uint64_t data = PROACTOR_MESSAGE | (uint64_t)(uintptr_t)op->channel;
+    if (op->send_fd) {
+        /*
+         * The target ring allocates a free slot in its own table and
+         * posts the index as the message. Count the handoff right away
+         * so that a burst of them spreads over the least loaded channels.
+         */
+        io_uring_prep_msg_ring_fd_alloc(sqe, op->channel->ring_fd, op->base.scratch, data, 0);
+        channel_add_load(op->channel, 1);
+    } else {
+        io_uring_prep_msg_ring(sqe, op->channel->ring_fd, (unsigned int)op->base.scratch, data, 0);
+    }
+
+    /* The posted message keeps the channel alive until it is reaped. */
+    Py_INCREF(op->channel);
+}
+
+static void msg_ring_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    MsgRingOperation *op = (MsgRingOperation *)self;
+
+    if (cqe->res < 0) {
+        /* The message never made it into the target ring. */
+        if (op->send_fd) {
+            channel_add_load(op->channel, -1);
+        }
+        Py_DECREF(op->channel);
+
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, Py_NewRef(Py_None));
+    }
+}
+
+static OperationVTable g_msg_ring_operation_vtable = {
+    .prepare  = msg_ring_prepare,
+    .complete = msg_ring_complete,
+};
+
+static PyObject *msg_ring_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf, bool send_fd) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    if (PyObject_TypeCheck(args[0], state->Channel_type) == 0) {
+        PyErr_SetString(PyExc_TypeError, "Expected Channel instance");
+        return NULL;
+    }
+
+    int value;
+    if (!python_parse_int(&value, args[1])) {
+        return NULL;
+    }
+
+    MsgRingOperation *op = (MsgRingOperation *)operation_alloc(state->MsgRingOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable  = &g_msg_ring_operation_vtable;
+        op->base.scratch = value;
+        op->channel      = (Channel *)Py_NewRef(args[0]);
+        op->send_fd      = send_fd;
+    }
+
+    return (PyObject *)op;
+}
+
+PyObject *msg_ring_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    return msg_ring_create(mod, args, nargsf, false);
+}
+
+PyObject *msg_ring_fd_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    return msg_ring_create(mod, args, nargsf, true);
+}
+
+static int msg_ring_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    MsgRingOperation *op = (MsgRingOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->channel);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int msg_ring_clear_impl(PyObject *self) {
+    MsgRingOperation *op = (MsgRingOperation *)self;
+
+    Py_CLEAR(op->channel);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_msg_ring_operation_slots[] = {
+    {Py_tp_traverse, msg_ring_traverse_impl},
+    {Py_tp_clear, msg_ring_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_msg_ring_operation_spec = {
+    .name      = "_impl._MsgRingOperation",
+    .basicsize = sizeof(MsgRingOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_msg_ring_operation_slots,
+};
+
+PyTypeObject *msg_ring_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_msg_ring_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
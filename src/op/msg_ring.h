@@ -0,0 +1,18 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "channel.h"
+#include "op/base.h"
+
+typedef struct {
+    Operation base;
+    Channel *channel;
+    /* Sends the direct descriptor in scratch instead of a message. */
+    bool send_fd;
+} MsgRingOperation;
+
+PyObject *msg_ring_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyObject *msg_ring_fd_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *msg_ring_operation_register(PyObject *mod);
@@ -0,0 +1,254 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/multishot.h"
+
+#include "util/python.h"
+
+#include <errno.h>
+
+#include "driver/handle.h"
+#include "module.h"
+
+/* MultishotOperation implementation */
+
+Operation *multishot_operation_alloc(PyTypeObject *tp, ImplState *state) {
+    MultishotOperation *op = (MultishotOperation *)operation_alloc(tp, state);
+    if (op != NULL) {
+        op->queue     = NULL;
+        op->head      = 0;
+        op->len       = 0;
+        op->cap       = 0;
+        op->finished  = false;
+        op->iterating = false;
+    }
+
+    return (Operation *)op;
+}
+
+int multishot_operation_traverse(MultishotOperation *self, visitproc visit, void *arg) {
+    for (size_t i = 0; i < self->len; ++i) {
+        int res = outcome_traverse(&self->queue[(self->head + i) % self->cap], visit, arg);
+        if (res != 0) {
+            return res;
+        }
+    }
+
+    return operation_traverse(&self->base, visit, arg);
+}
+
+int multishot_operation_clear(MultishotOperation *self) {
+    for (size_t i = 0; i < self->len; ++i) {
+        outcome_clear(&self->queue[(self->head + i) % self->cap]);
+    }
+
+    PyMem_Free(self->queue);
+    self->queue = NULL;
+    self->head  = 0;
+    self->len   = 0;
+    self->cap   = 0;
+
+    return operation_clear(&self->base);
+}
+
+static bool multishot_operation_grow(MultishotOperation *self) {
+    size_t cap     = self->cap == 0 ? 4 : self->cap * 2;
+    Outcome *queue = PyMem_Calloc(cap, sizeof(Outcome));
+    if (queue == NULL) {
+        return false;
+    }
+
+    /* Linearize the ring buffer into the new allocation. */
+    for (size_t i = 0; i < self->len; ++i) {
+        queue[i] = self->queue[(self->head + i) % self->cap];
+    }
+
+    PyMem_Free(self->queue);
+    self->queue = queue;
+    self->head  = 0;
+    self->cap   = cap;
+    return true;
+}
+
+static Outcome *multishot_operation_next_slot(MultishotOperation *self) {
+    if (self->len == self->cap && !multishot_operation_grow(self)) {
+        return NULL;
+    }
+
+    Outcome *slot = &self->queue[(self->head + self->len) % self->cap];
+    ++self->len;
+    return slot;
+}
+
+void multishot_operation_push(MultishotOperation *self, PyObject *ob) {
+    Outcome *slot = multishot_operation_next_slot(self);
+    if (slot == NULL) {
+        /* There's nowhere to report this, the result is lost. */
+        Py_XDECREF(ob);
+        PyErr_NoMemory();
+        PyErr_WriteUnraisable((PyObject *)self);
+        return;
+    }
+
+    outcome_init(slot);
+    outcome_capture(slot, ob);
+}
+
+void multishot_operation_push_errno(MultishotOperation *self, int err) {
+    /*
+     * Cancellation is the regular way of stopping a multishot operation
+     * from the outside. Treat it as the end of the stream, not an error.
+     */
+    if (err == ECANCELED) {
+        self->finished = true;
+        return;
+    }
+
+    Outcome *slot = multishot_operation_next_slot(self);
+    if (slot == NULL) {
+        PyErr_NoMemory();
+        PyErr_WriteUnraisable((PyObject *)self);
+        return;
+    }
+
+    outcome_init(slot);
+    errno = err;
+    outcome_capture_errno(slot);
+}
+
+static int multishot_operation_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    Py_VISIT(Py_TYPE(self));
+    return multishot_operation_traverse((MultishotOperation *)self, visit, arg);
+}
+
+static int multishot_operation_clear_impl(PyObject *self) {
+    return multishot_operation_clear((MultishotOperation *)self);
+}
+
+static PyObject *multishot_operation_misuse(PyObject *self) {
+    PyErr_Format(PyExc_TypeError, "%.200s must be consumed with 'async for'", Py_TYPE(self)->tp_name);
+    return NULL;
+}
+
+static PySendResult multishot_operation_send(PyObject *self, PyObject *arg, PyObject **presult) {
+    MultishotOperation *op = (MultishotOperation *)self;
+    (void)arg;
+
+    *presult = NULL;
+
+    if (!op->iterating) {
+        (void)multishot_operation_misuse(self);
+        return PYGEN_ERROR;
+    }
+
+    if (op->len > 0) {
+        /*
+         * Completions which arrived in the meantime are handed out
+         * immediately without suspending the task on the event loop,
+         * unless the task did so too often in a row already.
+         */
+        if (!runtime_coop_consume(op->base.module_state)) {
+            *presult = Py_NewRef(Py_None);
+            return PYGEN_NEXT;
+        }
+
+        Outcome outcome = op->queue[op->head];
+        op->head        = (op->head + 1) % op->cap;
+        --op->len;
+
+        op->iterating = false;
+        *presult      = outcome_unwrap(&outcome, &op->base.module_state->errno_cache);
+        return *presult != NULL ? PYGEN_RETURN : PYGEN_ERROR;
+    }
+
+    if (op->finished) {
+        op->iterating = false;
+        PyErr_SetNone(PyExc_StopAsyncIteration);
+        return PYGEN_ERROR;
+    }
+
+    if (op->base.awaiter != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Operation is already awaited by another task");
+        return PYGEN_ERROR;
+    }
+
+    /*
+     * Suspend until the next completion arrives. If the kernel dropped
+     * the multishot submission in the meantime (or it was never armed),
+     * the event loop transparently submits it again.
+     */
+    op->base.state = State_Blocked;
+    *presult       = Py_NewRef(self);
+    return PYGEN_NEXT;
+}
+
+/* Overrides the iterator inherited from Operation, see above. */
+static PyObject *multishot_operation_iternext(PyObject *self) {
+    PyObject *res;
+
+    switch (multishot_operation_send(self, Py_None, &res)) {
+    case PYGEN_NEXT:
+        return res;
+    case PYGEN_RETURN:
+        python_stop_iteration(res);
+        return NULL;
+    default:
+        return NULL;
+    }
+}
+
+/* Only the awaitable handed out by __anext__ may be awaited. */
+static PyObject *multishot_operation_await(PyObject *self) {
+    MultishotOperation *op = (MultishotOperation *)self;
+
+    if (!op->iterating) {
+        return multishot_operation_misuse(self);
+    }
+
+    return Py_NewRef(self);
+}
+
+static PyObject *multishot_operation_anext(PyObject *self) {
+    MultishotOperation *op = (MultishotOperation *)self;
+
+    /* Guard against attempts to build subclasses without a vtable. */
+    if (op->base.vtable == NULL) {
+        PyErr_SetString(PyExc_TypeError, "Invalid Operation subclass detected");
+        return NULL;
+    }
+
+    /*
+     * The operation doubles as the awaitable for its next result, so
+     * iterating does not allocate. It stays in that role until the
+     * result is handed out.
+     */
+    op->iterating = true;
+    return Py_NewRef(self);
+}
+
+// clang-format off
+static PyType_Slot g_multishot_operation_slots[] = {
+    {Py_tp_traverse, multishot_operation_traverse_impl},
+    {Py_tp_clear, multishot_operation_clear_impl},
+    {Py_tp_iternext, multishot_operation_iternext},
+    {Py_am_await, multishot_operation_await},
+    {Py_am_send, multishot_operation_send},
+    {Py_am_aiter, PyObject_SelfIter},
+    {Py_am_anext, multishot_operation_anext},
+    {0, NULL},
+};
+// clang-format on
+
+static PyType_Spec g_multishot_operation_spec = {
+    .name      = "_impl._MultishotOperation",
+    .basicsize = sizeof(MultishotOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_BASETYPE,
+    .slots     = g_multishot_operation_slots,
+};
+
+PyTypeObject *multishot_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_multishot_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
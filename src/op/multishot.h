@@ -0,0 +1,35 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "op/base.h"
+
+/*
+ * Base state for operations that post many completions from a single
+ * submission. Results are buffered until the owning task consumes them
+ * through the async iterator protocol.
+ */
+typedef struct {
+    Operation base;
+    Outcome *queue;
+    size_t head;
+    size_t len;
+    size_t cap;
+    bool finished;
+    /* Set by __anext__ until the awaited result is handed out. */
+    bool iterating;
+} MultishotOperation;
+
+Operation *multishot_operation_alloc(PyTypeObject *tp, struct _ImplState *state);
+
+int multishot_operation_traverse(MultishotOperation *self, visitproc visit, void *arg);
+int multishot_operation_clear(MultishotOperation *self);
+
+/* Buffers a result or, if ob is NULL, the currently raised exception. */
+void multishot_operation_push(MultishotOperation *self, PyObject *ob);
+
+/* Buffers an errno value. ECANCELED ends the stream instead. */
+void multishot_operation_push_errno(MultishotOperation *self, int err);
+
+PyTypeObject *multishot_operation_register(PyObject *mod);
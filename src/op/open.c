@@ -13,7 +13,11 @@ static void openat_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     OpenAtOperation *op = (OpenAtOperation *)self;
 
     const char *pathname = PyBytes_AS_STRING(op->path);
-    io_uring_prep_openat(sqe, op->dfd, pathname, op->base.scratch, op->mode);
+    if (op->direct) {
+        io_uring_prep_openat_direct(sqe, op->dfd, pathname, op->base.scratch, op->mode, IORING_FILE_INDEX_ALLOC);
+    } else {
+        io_uring_prep_openat(sqe, op->dfd, pathname, op->base.scratch, op->mode);
+    }
 }
 
 static void openat_complete(PyObject *self, struct io_uring_cqe *cqe) {
@@ -36,8 +40,8 @@ PyObject *openat_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 4) {
-        PyErr_Format(PyExc_TypeError, "Expected 4 arguments, got %zu instead", nargs);
+    if (nargs != 4 && nargs != 5) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 or 5 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -63,6 +67,12 @@ PyObject *openat_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 5 && !python_parse_bool(&direct, args[4])) {
+        Py_DECREF(path);
+        return NULL;
+    }
+
     OpenAtOperation *op = (OpenAtOperation *)operation_alloc(state->OpenAtOperation_type, state);
     if (op != NULL) {
         op->base.vtable  = &g_openat_operation_vtable;
@@ -70,6 +80,7 @@ PyObject *openat_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
         op->path         = path;
         op->dfd          = dfd;
         op->mode         = mode;
+        op->direct       = direct;
     } else {
         Py_DECREF(path);
     }
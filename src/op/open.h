@@ -13,6 +13,7 @@ typedef struct {
     PyObject *path;
     int dfd;
     mode_t mode;
+    bool direct;
 } OpenAtOperation;
 
 PyObject *openat_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
@@ -5,8 +5,11 @@
 
 #include "util/python.h"
 
+#include "driver/buffers.h"
 #include "module.h"
 
+/* ReadOperation implementation */
+
 static void read_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     ReadOperation *op = (ReadOperation *)self;
 
@@ -35,8 +38,8 @@ PyObject *read_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 3) {
-        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -55,6 +58,11 @@ PyObject *read_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
     PyObject *buf = PyBytes_FromStringAndSize(NULL, nbytes);
     if (buf == NULL) {
         return PyErr_NoMemory();
@@ -62,11 +70,12 @@ PyObject *read_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
 
     ReadOperation *op = (ReadOperation *)operation_alloc(state->ReadOperation_type, state);
     if (op != NULL) {
-        op->base.vtable  = &g_read_operation_vtable;
-        op->base.scratch = fd;
-        op->buf          = buf;
-        op->nbytes       = nbytes;
-        op->offset       = offset;
+        op->base.vtable    = &g_read_operation_vtable;
+        op->base.scratch   = fd;
+        op->buf            = buf;
+        op->nbytes         = nbytes;
+        op->offset         = offset;
+        op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
     }
 
     return (PyObject *)op;
@@ -105,3 +114,334 @@ PyTypeObject *read_operation_register(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_read_operation_spec, (PyObject *)state->Operation_type);
 }
+
+/* ReadIntoOperation implementation */
+
+static void readinto_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    ReadIntoOperation *op = (ReadIntoOperation *)self;
+
+    io_uring_prep_read(sqe, op->base.scratch, op->view.buf, op->nbytes, op->offset);
+}
+
+static void readinto_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    ReadIntoOperation *op = (ReadIntoOperation *)self;
+
+    /* The kernel is done writing, so the exporter may resize again. */
+    python_release_buffer(&op->view);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_readinto_operation_vtable = {
+    .prepare  = readinto_prepare,
+    .complete = readinto_complete,
+};
+
+PyObject *readinto_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4 && nargs != 5) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 or 5 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned int nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[2])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[3])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 5 && !python_parse_bool(&direct, args[4])) {
+        return NULL;
+    }
+
+    ReadIntoOperation *op = (ReadIntoOperation *)operation_alloc(state->ReadIntoOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_readinto_operation_vtable;
+    op->base.scratch   = fd;
+    op->nbytes         = nbytes;
+    op->offset         = offset;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* The exported buffer stays locked until the read completed. */
+    if (!python_get_buffer(&op->view, args[1], true, nbytes)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+static int readinto_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    ReadIntoOperation *op = (ReadIntoOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->view.obj);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int readinto_clear_impl(PyObject *self) {
+    ReadIntoOperation *op = (ReadIntoOperation *)self;
+
+    python_release_buffer(&op->view);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_readinto_operation_slots[] = {
+    {Py_tp_traverse, readinto_traverse_impl},
+    {Py_tp_clear, readinto_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_readinto_operation_spec = {
+    .name      = "_impl._ReadIntoOperation",
+    .basicsize = sizeof(ReadIntoOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_readinto_operation_slots,
+};
+
+PyTypeObject *readinto_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_readinto_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* ReadvOperation implementation */
+
+static void readv_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    ReadvOperation *op = (ReadvOperation *)self;
+
+    io_uring_prep_readv(sqe, op->base.scratch, op->vec.iov, op->vec.count, op->offset);
+}
+
+static void readv_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    ReadvOperation *op = (ReadvOperation *)self;
+
+    buffer_vector_release(&op->vec);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_readv_operation_vtable = {
+    .prepare  = readv_prepare,
+    .complete = readv_complete,
+};
+
+PyObject *readv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[2])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
+    ReadvOperation *op = (ReadvOperation *)operation_alloc(state->ReadvOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_readv_operation_vtable;
+    op->base.scratch   = fd;
+    op->offset         = offset;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* All buffers stay locked until the kernel filled them. */
+    if (!buffer_vector_init(&op->vec, args[1], true)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+static int readv_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    ReadvOperation *op = (ReadvOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+
+    int res = buffer_vector_traverse(&op->vec, visit, arg);
+    if (res != 0) {
+        return res;
+    }
+
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int readv_clear_impl(PyObject *self) {
+    ReadvOperation *op = (ReadvOperation *)self;
+
+    buffer_vector_release(&op->vec);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_readv_operation_slots[] = {
+    {Py_tp_traverse, readv_traverse_impl},
+    {Py_tp_clear, readv_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_readv_operation_spec = {
+    .name      = "_impl._ReadvOperation",
+    .basicsize = sizeof(ReadvOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_readv_operation_slots,
+};
+
+PyTypeObject *readv_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_readv_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* ReadFixedOperation implementation */
+
+static void read_fixed_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    ReadFixedOperation *op = (ReadFixedOperation *)self;
+
+    io_uring_prep_read_fixed(sqe, op->base.scratch, op->buf->data, op->nbytes, op->offset, op->buf->bid);
+}
+
+static void read_fixed_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    ReadFixedOperation *op = (ReadFixedOperation *)self;
+
+    /* The kernel is done with the buffer, so Python code may release it again. */
+    fixed_buffer_unpin(op->buf);
+    Py_CLEAR(op->buf);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_read_fixed_operation_vtable = {
+    .prepare  = read_fixed_prepare,
+    .complete = read_fixed_complete,
+};
+
+PyObject *read_fixed_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned int nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[2])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[3])) {
+        return NULL;
+    }
+
+    LeasedBuffer *buf = fixed_buffer_pin(state, args[1], nbytes);
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    ReadFixedOperation *op = (ReadFixedOperation *)operation_alloc(state->ReadFixedOperation_type, state);
+    if (op == NULL) {
+        fixed_buffer_unpin(buf);
+        Py_DECREF(buf);
+        return NULL;
+    }
+
+    op->base.vtable  = &g_read_fixed_operation_vtable;
+    op->base.scratch = fd;
+    op->buf          = buf;
+    op->nbytes       = nbytes;
+    op->offset       = offset;
+
+    return (PyObject *)op;
+}
+
+static int read_fixed_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    ReadFixedOperation *op = (ReadFixedOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->buf);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int read_fixed_clear_impl(PyObject *self) {
+    ReadFixedOperation *op = (ReadFixedOperation *)self;
+
+    if (op->buf != NULL) {
+        fixed_buffer_unpin(op->buf);
+        Py_CLEAR(op->buf);
+    }
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_read_fixed_operation_slots[] = {
+    {Py_tp_traverse, read_fixed_traverse_impl},
+    {Py_tp_clear, read_fixed_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_read_fixed_operation_spec = {
+    .name      = "_impl._ReadFixedOperation",
+    .basicsize = sizeof(ReadFixedOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_read_fixed_operation_slots,
+};
+
+PyTypeObject *read_fixed_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_read_fixed_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
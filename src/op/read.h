@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "driver/buffers.h"
 #include "op/base.h"
+#include "util/iovec.h"
 
 typedef struct {
     /* fd is stored in base.scratch */
@@ -13,5 +15,37 @@ typedef struct {
     unsigned long long offset;
 } ReadOperation;
 
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    LeasedBuffer *buf;
+    unsigned int nbytes;
+    unsigned long long offset;
+} ReadFixedOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    Py_buffer view;
+    unsigned int nbytes;
+    unsigned long long offset;
+} ReadIntoOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    BufferVector vec;
+    unsigned long long offset;
+} ReadvOperation;
+
 PyObject *read_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 PyTypeObject *read_operation_register(PyObject *mod);
+
+PyObject *readinto_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *readinto_operation_register(PyObject *mod);
+
+PyObject *readv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *readv_operation_register(PyObject *mod);
+
+PyObject *read_fixed_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *read_fixed_operation_register(PyObject *mod);
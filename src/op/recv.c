@@ -5,8 +5,11 @@
 
 #include "util/python.h"
 
+#include "driver/handle.h"
 #include "module.h"
 
+/* RecvOperation implementation */
+
 static void recv_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     RecvOperation *op = (RecvOperation *)self;
 
@@ -35,8 +38,8 @@ PyObject *recv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 3) {
-        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -55,6 +58,11 @@ PyObject *recv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
     PyObject *buf = PyBytes_FromStringAndSize(NULL, nbytes);
     if (buf == NULL) {
         return PyErr_NoMemory();
@@ -62,11 +70,12 @@ PyObject *recv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
 
     RecvOperation *op = (RecvOperation *)operation_alloc(state->RecvOperation_type, state);
     if (op != NULL) {
-        op->base.vtable  = &g_recv_operation_vtable;
-        op->base.scratch = fd;
-        op->buf          = buf;
-        op->nbytes       = nbytes;
-        op->flags        = flags;
+        op->base.vtable    = &g_recv_operation_vtable;
+        op->base.scratch   = fd;
+        op->buf            = buf;
+        op->nbytes         = nbytes;
+        op->flags          = flags;
+        op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
     }
 
     return (PyObject *)op;
@@ -105,3 +114,465 @@ PyTypeObject *recv_operation_register(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_recv_operation_spec, (PyObject *)state->Operation_type);
 }
+
+/* RecvIntoOperation implementation */
+
+static void recv_into_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    RecvIntoOperation *op = (RecvIntoOperation *)self;
+
+    io_uring_prep_recv(sqe, op->base.scratch, op->view.buf, op->nbytes, op->flags);
+}
+
+static void recv_into_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    RecvIntoOperation *op = (RecvIntoOperation *)self;
+
+    python_release_buffer(&op->view);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_recv_into_operation_vtable = {
+    .prepare  = recv_into_prepare,
+    .complete = recv_into_complete,
+};
+
+PyObject *recv_into_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4 && nargs != 5) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 or 5 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned int nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[2])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[3])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 5 && !python_parse_bool(&direct, args[4])) {
+        return NULL;
+    }
+
+    RecvIntoOperation *op = (RecvIntoOperation *)operation_alloc(state->RecvIntoOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_recv_into_operation_vtable;
+    op->base.scratch   = fd;
+    op->nbytes         = nbytes;
+    op->flags          = flags;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* The exported buffer stays locked until the receive completed. */
+    if (!python_get_buffer(&op->view, args[1], true, nbytes)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+static int recv_into_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    RecvIntoOperation *op = (RecvIntoOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->view.obj);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int recv_into_clear_impl(PyObject *self) {
+    RecvIntoOperation *op = (RecvIntoOperation *)self;
+
+    python_release_buffer(&op->view);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_recv_into_operation_slots[] = {
+    {Py_tp_traverse, recv_into_traverse_impl},
+    {Py_tp_clear, recv_into_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_recv_into_operation_spec = {
+    .name      = "_impl._RecvIntoOperation",
+    .basicsize = sizeof(RecvIntoOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_recv_into_operation_slots,
+};
+
+PyTypeObject *recv_into_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_recv_into_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* RecvmsgOperation implementation */
+
+static void recvmsg_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    RecvmsgOperation *op = (RecvmsgOperation *)self;
+
+    io_uring_prep_recvmsg(sqe, op->base.scratch, &op->msg, op->flags);
+}
+
+static void recvmsg_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    RecvmsgOperation *op = (RecvmsgOperation *)self;
+
+    buffer_vector_release(&op->vec);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_recvmsg_operation_vtable = {
+    .prepare  = recvmsg_prepare,
+    .complete = recvmsg_complete,
+};
+
+PyObject *recvmsg_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[2])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
+    RecvmsgOperation *op = (RecvmsgOperation *)operation_alloc(state->RecvmsgOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_recvmsg_operation_vtable;
+    op->base.scratch   = fd;
+    op->flags          = flags;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* All buffers stay locked until the kernel filled them. */
+    if (!buffer_vector_init(&op->vec, args[1], true)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    op->msg.msg_iov    = op->vec.iov;
+    op->msg.msg_iovlen = op->vec.count;
+
+    return (PyObject *)op;
+}
+
+static int recvmsg_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    RecvmsgOperation *op = (RecvmsgOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+
+    int res = buffer_vector_traverse(&op->vec, visit, arg);
+    if (res != 0) {
+        return res;
+    }
+
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int recvmsg_clear_impl(PyObject *self) {
+    RecvmsgOperation *op = (RecvmsgOperation *)self;
+
+    buffer_vector_release(&op->vec);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_recvmsg_operation_slots[] = {
+    {Py_tp_traverse, recvmsg_traverse_impl},
+    {Py_tp_clear, recvmsg_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_recvmsg_operation_spec = {
+    .name      = "_impl._RecvmsgOperation",
+    .basicsize = sizeof(RecvmsgOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_recvmsg_operation_slots,
+};
+
+PyTypeObject *recvmsg_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_recvmsg_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* RecvBufferOperation implementation */
+
+static BufferRing *get_local_buffer_ring(ImplState *state) {
+    RuntimeHandle *rt = runtime_get_local(state);
+    if (rt == NULL) {
+        return NULL;
+    }
+
+    if (rt->buffers == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "No provided buffer ring configured, set RunConfig.pbuf_count");
+        return NULL;
+    }
+
+    return rt->buffers;
+}
+
+static void recv_buffer_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    RecvBufferOperation *op = (RecvBufferOperation *)self;
+
+    /* Let the kernel pick a buffer from the pool once data arrives. */
+    io_uring_prep_recv(sqe, op->base.scratch, NULL, 0, op->flags);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = op->pool->bgid;
+}
+
+static void recv_buffer_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    RecvBufferOperation *op = (RecvBufferOperation *)self;
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        int bid = -1;
+        if ((cqe->flags & IORING_CQE_F_BUFFER) != 0) {
+            bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+        }
+
+        LeasedBuffer *lease = buffer_ring_lease(op->pool, bid, cqe->res);
+        outcome_capture(&op->base.outcome, (PyObject *)lease);
+    }
+}
+
+static OperationVTable g_recv_buffer_operation_vtable = {
+    .prepare  = recv_buffer_prepare,
+    .complete = recv_buffer_complete,
+};
+
+PyObject *recv_buffer_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[1])) {
+        return NULL;
+    }
+
+    BufferRing *pool = get_local_buffer_ring(state);
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    RecvBufferOperation *op = (RecvBufferOperation *)operation_alloc(state->RecvBufferOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable  = &g_recv_buffer_operation_vtable;
+        op->base.scratch = fd;
+        op->pool         = (BufferRing *)Py_NewRef(pool);
+        op->flags        = flags;
+    }
+
+    return (PyObject *)op;
+}
+
+static int recv_buffer_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    RecvBufferOperation *op = (RecvBufferOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->pool);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int recv_buffer_clear_impl(PyObject *self) {
+    RecvBufferOperation *op = (RecvBufferOperation *)self;
+
+    Py_CLEAR(op->pool);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_recv_buffer_operation_slots[] = {
+    {Py_tp_traverse, recv_buffer_traverse_impl},
+    {Py_tp_clear, recv_buffer_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_recv_buffer_operation_spec = {
+    .name      = "_impl._RecvBufferOperation",
+    .basicsize = sizeof(RecvBufferOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_recv_buffer_operation_slots,
+};
+
+PyTypeObject *recv_buffer_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_recv_buffer_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* RecvMultishotOperation implementation */
+
+static void recv_multishot_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    RecvMultishotOperation *op = (RecvMultishotOperation *)self;
+
+    io_uring_prep_recv_multishot(sqe, op->base.base.scratch, NULL, 0, op->flags);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = op->pool->bgid;
+}
+
+static void recv_multishot_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    RecvMultishotOperation *op = (RecvMultishotOperation *)self;
+
+    if (cqe->res < 0) {
+        /*
+         * Running out of buffers terminates the multishot submission.
+         * As long as there are buffered results, consuming them frees
+         * up buffers and the next iteration re-arms the operation. Only
+         * report the error if holding on to leases is what starves us.
+         */
+        if (cqe->res == -ENOBUFS && op->base.len > 0) {
+            return;
+        }
+
+        multishot_operation_push_errno(&op->base, -cqe->res);
+        return;
+    }
+
+    int bid = -1;
+    if ((cqe->flags & IORING_CQE_F_BUFFER) != 0) {
+        bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+    }
+
+    if (cqe->res == 0) {
+        /* The peer closed the connection, which ends the stream. */
+        if (bid >= 0) {
+            Py_XDECREF(buffer_ring_lease(op->pool, bid, 0));
+        }
+
+        op->base.finished = true;
+        return;
+    }
+
+    LeasedBuffer *lease = buffer_ring_lease(op->pool, bid, cqe->res);
+    multishot_operation_push(&op->base, (PyObject *)lease);
+}
+
+static OperationVTable g_recv_multishot_operation_vtable = {
+    .prepare  = recv_multishot_prepare,
+    .complete = recv_multishot_complete,
+};
+
+PyObject *recv_multishot_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[1])) {
+        return NULL;
+    }
+
+    BufferRing *pool = get_local_buffer_ring(state);
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    RecvMultishotOperation *op =
+        (RecvMultishotOperation *)multishot_operation_alloc(state->RecvMultishotOperation_type, state);
+    if (op != NULL) {
+        op->base.base.vtable  = &g_recv_multishot_operation_vtable;
+        op->base.base.scratch = fd;
+        op->pool              = (BufferRing *)Py_NewRef(pool);
+        op->flags             = flags;
+    }
+
+    return (PyObject *)op;
+}
+
+static int recv_multishot_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    RecvMultishotOperation *op = (RecvMultishotOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->pool);
+    return multishot_operation_traverse(&op->base, visit, arg);
+}
+
+static int recv_multishot_clear_impl(PyObject *self) {
+    RecvMultishotOperation *op = (RecvMultishotOperation *)self;
+
+    Py_CLEAR(op->pool);
+    return multishot_operation_clear(&op->base);
+}
+
+static PyType_Slot g_recv_multishot_operation_slots[] = {
+    {Py_tp_traverse, recv_multishot_traverse_impl},
+    {Py_tp_clear, recv_multishot_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_recv_multishot_operation_spec = {
+    .name      = "_impl._RecvMultishotOperation",
+    .basicsize = sizeof(RecvMultishotOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_recv_multishot_operation_slots,
+};
+
+PyTypeObject *recv_multishot_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_recv_multishot_operation_spec,
+                                                    (PyObject *)state->MultishotOperation_type);
+}
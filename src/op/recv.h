@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include "driver/buffers.h"
 #include "op/base.h"
+#include "op/multishot.h"
+#include "util/iovec.h"
+
+#include <sys/socket.h>
 
 typedef struct {
     /* fd is stored in base.scratch */
@@ -13,5 +18,47 @@ typedef struct {
     int flags;
 } RecvOperation;
 
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    Py_buffer view;
+    unsigned int nbytes;
+    int flags;
+} RecvIntoOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    BufferVector vec;
+    struct msghdr msg;
+    int flags;
+} RecvmsgOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    BufferRing *pool;
+    int flags;
+} RecvBufferOperation;
+
+typedef struct {
+    /* fd is stored in base.base.scratch */
+    MultishotOperation base;
+    BufferRing *pool;
+    int flags;
+} RecvMultishotOperation;
+
 PyObject *recv_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 PyTypeObject *recv_operation_register(PyObject *mod);
+
+PyObject *recv_into_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *recv_into_operation_register(PyObject *mod);
+
+PyObject *recvmsg_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *recvmsg_operation_register(PyObject *mod);
+
+PyObject *recv_buffer_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *recv_buffer_operation_register(PyObject *mod);
+
+PyObject *recv_multishot_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *recv_multishot_operation_register(PyObject *mod);
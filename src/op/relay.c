@@ -0,0 +1,318 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/relay.h"
+
+#include "util/python.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "module.h"
+
+/* The most a single round moves, which matches the default pipe size. */
+#define RELAY_CHUNK (64 * 1024)
+
+/* The submissions that make up a round of one direction. */
+typedef enum {
+    Leg_Fill,
+    Leg_Drain,
+    Leg_Shutdown,
+    Leg_Count,
+} RelayLeg;
+
+static_assert(PROACTOR_TAG_LEG + 2 * Leg_Count - 1 <= PROACTOR_TAG_MASK, "Relay legs exceed the tag space");
+
+static inline uint64_t relay_leg_data(RelayOperation *self, size_t dir, RelayLeg leg) {
+    return proactor_tag(&self->base, PROACTOR_TAG_LEG + dir * Leg_Count + leg);
+}
+
+static inline void relay_close_fd(int *fd) {
+    if (*fd >= 0) {
+        close(*fd);
+        *fd = -1;
+    }
+}
+
+static void relay_close_pipes(RelayOperation *self) {
+    for (size_t dir = 0; dir < 2; ++dir) {
+        relay_close_fd(&self->pipes[dir].pipe[0]);
+        relay_close_fd(&self->pipes[dir].pipe[1]);
+    }
+}
+
+/* Keeps the raised exception as the result, unless there already is one. */
+static void relay_capture_error(RelayOperation *self) {
+    if (outcome_empty(&self->base.outcome)) {
+        outcome_capture_error(&self->base.outcome);
+    } else {
+        PyErr_Clear();
+    }
+}
+
+static void relay_fail(RelayOperation *self, int error) {
+    if (self->error != 0) {
+        return;
+    }
+
+    self->error = error;
+
+    for (size_t dir = 0; dir < 2; ++dir) {
+        RelayPipe *pipe = &self->pipes[dir];
+
+        /*
+         * Without a writer, a drain waiting on an empty pipe returns
+         * right away. Everything else still in flight may block on a
+         * peer indefinitely and has to be cancelled.
+         */
+        relay_close_fd(&pipe->pipe[1]);
+        if (pipe->inflight == 0) {
+            continue;
+        }
+
+        if (!proactor_reserve(self->proactor, 2)) {
+            relay_capture_error(self);
+            continue;
+        }
+
+        for (RelayLeg leg = Leg_Fill; leg <= Leg_Drain; ++leg) {
+            struct io_uring_sqe *sqe = proactor_get_submission(self->proactor);
+            assert(sqe != NULL);
+
+            io_uring_prep_cancel64(sqe, relay_leg_data(self, dir, leg), 0);
+            io_uring_sqe_set_data(sqe, NULL);
+        }
+    }
+}
+
+static bool relay_pump(RelayOperation *self, size_t dir) {
+    RelayPipe *pipe = &self->pipes[dir];
+    struct io_uring_sqe *sqe;
+
+    if (!proactor_reserve(self->proactor, 2)) {
+        return false;
+    }
+
+    if (pipe->buffered > 0) {
+        /* The destination did not take everything, flush the rest. */
+        sqe = proactor_get_submission(self->proactor);
+        io_uring_prep_splice(sqe, pipe->pipe[0], -1, pipe->dst, -1, pipe->buffered, SPLICE_F_MOVE);
+        io_uring_sqe_set_data64(sqe, relay_leg_data(self, dir, Leg_Drain));
+        pipe->inflight = 1;
+    } else if (pipe->eof) {
+        /* Forward the end of file so that the peer sees it too. */
+        sqe = proactor_get_submission(self->proactor);
+        io_uring_prep_shutdown(sqe, pipe->dst, SHUT_WR);
+        io_uring_sqe_set_data64(sqe, relay_leg_data(self, dir, Leg_Shutdown));
+        pipe->inflight = 1;
+    } else {
+        /*
+         * Splices from a socket are usually short, which would cancel
+         * a softly linked drain. With a hard link, the drain always
+         * runs and moves whatever the fill left in the pipe.
+         */
+        sqe = proactor_get_submission(self->proactor);
+        io_uring_prep_splice(sqe, pipe->src, -1, pipe->pipe[1], -1, RELAY_CHUNK, SPLICE_F_MOVE);
+        io_uring_sqe_set_data64(sqe, relay_leg_data(self, dir, Leg_Fill));
+        sqe->flags |= IOSQE_IO_HARDLINK;
+
+        sqe = proactor_get_submission(self->proactor);
+        io_uring_prep_splice(sqe, pipe->pipe[0], -1, pipe->dst, -1, RELAY_CHUNK, SPLICE_F_MOVE);
+        io_uring_sqe_set_data64(sqe, relay_leg_data(self, dir, Leg_Drain));
+        pipe->inflight = 2;
+    }
+
+    return true;
+}
+
+static void relay_finish(RelayOperation *self) {
+    relay_close_pipes(self);
+
+    if (outcome_empty(&self->base.outcome)) {
+        if (self->error != 0) {
+            errno = self->error;
+            outcome_capture_errno(&self->base.outcome);
+        } else {
+            PyObject *res = Py_BuildValue("(KK)", self->pipes[0].total, self->pipes[1].total);
+            outcome_capture(&self->base.outcome, res);
+        }
+    }
+
+    /* This tells the proactor to wake the awaiter and let go of us. */
+    self->base.inflight = false;
+}
+
+static void relay_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    (void)self;
+    (void)sqe;
+
+    /* Relays are submitted via relay_operation_submit instead. */
+    Py_UNREACHABLE();
+}
+
+static void relay_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    RelayOperation *op = (RelayOperation *)self;
+
+    unsigned id     = (io_uring_cqe_get_data64(cqe) & PROACTOR_TAG_MASK) - PROACTOR_TAG_LEG;
+    size_t dir      = id / Leg_Count;
+    RelayPipe *pipe = &op->pipes[dir];
+    int res         = cqe->res;
+
+    assert(pipe->inflight > 0);
+    --pipe->inflight;
+
+    switch ((RelayLeg)(id % Leg_Count)) {
+    case Leg_Fill:
+        if (res > 0) {
+            pipe->buffered += res;
+        } else {
+            /* Close the pipe for writing so the linked drain returns. */
+            relay_close_fd(&pipe->pipe[1]);
+            pipe->eof = true;
+
+            if (res < 0) {
+                relay_fail(op, -res);
+            }
+        }
+        break;
+
+    case Leg_Drain:
+        if (res > 0) {
+            pipe->buffered -= res;
+            pipe->total += res;
+        } else if (res < 0) {
+            relay_fail(op, -res);
+        }
+        break;
+
+    case Leg_Shutdown:
+        /* Destinations which are gone or no sockets have nothing to be told. */
+        if (res < 0 && res != -ENOTCONN && res != -ENOTSOCK) {
+            relay_fail(op, -res);
+        }
+
+        pipe->done = true;
+        break;
+
+    default:
+        Py_UNREACHABLE();
+    }
+
+    if (pipe->inflight == 0 && !pipe->done && op->error == 0) {
+        if (op->proactor->closing) {
+            relay_fail(op, ECANCELED);
+        } else if (!relay_pump(op, dir)) {
+            relay_capture_error(op);
+            relay_fail(op, ECANCELED);
+        }
+    }
+
+    RelayPipe *other = &op->pipes[dir ^ 1];
+    if (pipe->inflight == 0 && other->inflight == 0 && (op->error != 0 || (pipe->done && other->done))) {
+        relay_finish(op);
+    }
+}
+
+static OperationVTable g_relay_operation_vtable = {
+    .prepare  = relay_prepare,
+    .complete = relay_complete,
+};
+
+PyObject *relay_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fds[2];
+    for (size_t i = 0; i < 2; ++i) {
+        if (!python_parse_int(&fds[i], args[i])) {
+            return NULL;
+        }
+    }
+
+    RelayOperation *op = (RelayOperation *)operation_alloc(state->RelayOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable = &g_relay_operation_vtable;
+    op->proactor    = NULL;
+    op->error       = 0;
+
+    for (size_t dir = 0; dir < 2; ++dir) {
+        RelayPipe *pipe = &op->pipes[dir];
+
+        pipe->src      = fds[dir];
+        pipe->dst      = fds[dir ^ 1];
+        pipe->pipe[0]  = -1;
+        pipe->pipe[1]  = -1;
+        pipe->buffered = 0;
+        pipe->inflight = 0;
+        pipe->eof      = false;
+        pipe->done     = false;
+        pipe->total    = 0;
+    }
+
+    for (size_t dir = 0; dir < 2; ++dir) {
+        if (pipe2(op->pipes[dir].pipe, O_CLOEXEC) != 0) {
+            PyErr_SetFromErrno(PyExc_OSError);
+            Py_DECREF(op);
+            return NULL;
+        }
+    }
+
+    return (PyObject *)op;
+}
+
+int relay_operation_submit(RelayOperation *self, Proactor *proactor) {
+    if (self->pipes[0].pipe[1] < 0 || self->pipes[1].pipe[1] < 0) {
+        PyErr_SetString(PyExc_RuntimeError, "Relay was already used");
+        return -1;
+    }
+
+    /* Reserve both first rounds upfront, so that none is left half-submitted. */
+    if (!proactor_reserve(proactor, 4)) {
+        return -1;
+    }
+
+    self->proactor = proactor;
+    for (size_t dir = 0; dir < 2; ++dir) {
+        bool res = relay_pump(self, dir);
+        assert(res);
+        (void)res;
+    }
+
+    self->base.inflight = true;
+    return 0;
+}
+
+static int relay_clear_impl(PyObject *self) {
+    RelayOperation *op = (RelayOperation *)self;
+
+    relay_close_pipes(op);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_relay_operation_slots[] = {
+    {Py_tp_clear, relay_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_relay_operation_spec = {
+    .name      = "_impl._RelayOperation",
+    .basicsize = sizeof(RelayOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_relay_operation_slots,
+};
+
+PyTypeObject *relay_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_relay_operation_spec, (PyObject *)state->Operation_type);
+}
@@ -0,0 +1,45 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "driver/proactor.h"
+#include "op/base.h"
+
+/* One direction of a relay, moving data from src to dst through a pipe. */
+typedef struct {
+    int src;
+    int dst;
+    /* The read and write end of the pipe, in that order. */
+    int pipe[2];
+    /* Bytes spliced into the pipe which did not reach dst yet. */
+    unsigned buffered;
+    /* Submissions of this direction which are still in flight. */
+    unsigned inflight;
+    bool eof;
+    bool done;
+    unsigned long long total;
+} RelayPipe;
+
+/*
+ * Pumps data between two descriptors in both directions until each
+ * side reached end of file. Every round of a direction splices from
+ * the source into a pipe and from the pipe into the destination with
+ * two linked submissions, so the data never enters userspace. The
+ * relay completes only once, with the byte counts of both directions.
+ */
+typedef struct {
+    Operation base;
+    RelayPipe pipes[2];
+    /* The proactor which receives follow-up submissions. */
+    Proactor *proactor;
+    /* The first error that stopped the relay, as a positive errno. */
+    int error;
+} RelayOperation;
+
+PyObject *relay_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
+/* Submits the first round of both directions of the relay. */
+int relay_operation_submit(RelayOperation *self, Proactor *proactor);
+
+PyTypeObject *relay_operation_register(PyObject *mod);
@@ -7,22 +7,24 @@
 
 #include "module.h"
 
+/* SendOperation implementation */
+
 static void send_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     SendOperation *op = (SendOperation *)self;
 
-    char *buf     = PyBytes_AS_STRING(op->buf);
-    size_t nbytes = PyBytes_Size(op->buf);
-    io_uring_prep_send(sqe, op->base.scratch, buf, nbytes, op->flags);
+    io_uring_prep_send(sqe, op->base.scratch, op->view.buf, op->view.len, op->flags);
 }
 
 static void send_complete(PyObject *self, struct io_uring_cqe *cqe) {
-    Operation *op = (Operation *)self;
+    SendOperation *op = (SendOperation *)self;
+
+    python_release_buffer(&op->view);
 
     if (cqe->res < 0) {
         errno = -cqe->res;
-        outcome_capture_errno(&op->outcome);
+        outcome_capture_errno(&op->base.outcome);
     } else {
-        outcome_capture(&op->outcome, PyLong_FromLong(cqe->res));
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
     }
 }
 
@@ -35,8 +37,8 @@ PyObject *send_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 3) {
-        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -45,23 +47,30 @@ PyObject *send_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t
         return NULL;
     }
 
-    PyObject *buf = args[1];
-    if (!PyBytes_Check(buf)) {
-        PyErr_Format(PyExc_TypeError, "Expected variable of type bytes");
+    int flags;
+    if (!python_parse_int(&flags, args[2])) {
         return NULL;
     }
 
-    int flags;
-    if (!python_parse_int(&flags, args[2])) {
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
         return NULL;
     }
 
     SendOperation *op = (SendOperation *)operation_alloc(state->SendOperation_type, state);
-    if (op != NULL) {
-        op->base.vtable  = &g_send_operation_vtable;
-        op->base.scratch = fd;
-        op->buf          = Py_NewRef(buf);
-        op->flags        = flags;
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_send_operation_vtable;
+    op->base.scratch   = fd;
+    op->flags          = flags;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* The exported buffer stays locked until the send completed. */
+    if (!python_get_buffer(&op->view, args[1], false, 0)) {
+        Py_DECREF(op);
+        return NULL;
     }
 
     return (PyObject *)op;
@@ -71,14 +80,14 @@ static int send_traverse_impl(PyObject *self, visitproc visit, void *arg) {
     SendOperation *op = (SendOperation *)self;
 
     Py_VISIT(Py_TYPE(self));
-    Py_VISIT(op->buf);
+    Py_VISIT(op->view.obj);
     return operation_traverse(&op->base, visit, arg);
 }
 
 static int send_clear_impl(PyObject *self) {
     SendOperation *op = (SendOperation *)self;
 
-    Py_CLEAR(op->buf);
+    python_release_buffer(&op->view);
     return operation_clear(&op->base);
 }
 
@@ -100,3 +109,226 @@ PyTypeObject *send_operation_register(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_send_operation_spec, (PyObject *)state->Operation_type);
 }
+
+/* SendmsgOperation implementation */
+
+static void sendmsg_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    SendmsgOperation *op = (SendmsgOperation *)self;
+
+    io_uring_prep_sendmsg(sqe, op->base.scratch, &op->msg, op->flags);
+}
+
+static void sendmsg_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    SendmsgOperation *op = (SendmsgOperation *)self;
+
+    buffer_vector_release(&op->vec);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_sendmsg_operation_vtable = {
+    .prepare  = sendmsg_prepare,
+    .complete = sendmsg_complete,
+};
+
+PyObject *sendmsg_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[2])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
+    SendmsgOperation *op = (SendmsgOperation *)operation_alloc(state->SendmsgOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_sendmsg_operation_vtable;
+    op->base.scratch   = fd;
+    op->flags          = flags;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* All buffers stay locked until the send completed. */
+    if (!buffer_vector_init(&op->vec, args[1], false)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    op->msg.msg_iov    = op->vec.iov;
+    op->msg.msg_iovlen = op->vec.count;
+
+    return (PyObject *)op;
+}
+
+static int sendmsg_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    SendmsgOperation *op = (SendmsgOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+
+    int res = buffer_vector_traverse(&op->vec, visit, arg);
+    if (res != 0) {
+        return res;
+    }
+
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int sendmsg_clear_impl(PyObject *self) {
+    SendmsgOperation *op = (SendmsgOperation *)self;
+
+    buffer_vector_release(&op->vec);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_sendmsg_operation_slots[] = {
+    {Py_tp_traverse, sendmsg_traverse_impl},
+    {Py_tp_clear, sendmsg_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_sendmsg_operation_spec = {
+    .name      = "_impl._SendmsgOperation",
+    .basicsize = sizeof(SendmsgOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_sendmsg_operation_slots,
+};
+
+PyTypeObject *sendmsg_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_sendmsg_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* SendZcOperation implementation */
+
+static void send_zc_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    SendZcOperation *op = (SendZcOperation *)self;
+
+    io_uring_prep_send_zc(sqe, op->base.scratch, op->view.buf, op->view.len, op->flags, 0);
+}
+
+static void send_zc_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    SendZcOperation *op = (SendZcOperation *)self;
+
+    /*
+     * A zero-copy send posts up to two completions. The first one
+     * carries the result and wakes the task, but the kernel may still
+     * reference the pages until the IORING_CQE_F_NOTIF completion.
+     */
+    if ((cqe->flags & IORING_CQE_F_NOTIF) != 0) {
+        python_release_buffer(&op->view);
+        return;
+    }
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+
+    /* Without a pending notification, the buffer is no longer in use. */
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
+        python_release_buffer(&op->view);
+    }
+}
+
+static OperationVTable g_send_zc_operation_vtable = {
+    .prepare  = send_zc_prepare,
+    .complete = send_zc_complete,
+};
+
+PyObject *send_zc_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 3) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    int flags;
+    if (!python_parse_int(&flags, args[2])) {
+        return NULL;
+    }
+
+    SendZcOperation *op = (SendZcOperation *)operation_alloc(state->SendZcOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable  = &g_send_zc_operation_vtable;
+    op->base.scratch = fd;
+    op->flags        = flags;
+
+    /* The exported buffer stays locked until the kernel lets go of it. */
+    if (!python_get_buffer(&op->view, args[1], false, 0)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+static int send_zc_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    SendZcOperation *op = (SendZcOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->view.obj);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int send_zc_clear_impl(PyObject *self) {
+    SendZcOperation *op = (SendZcOperation *)self;
+
+    python_release_buffer(&op->view);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_send_zc_operation_slots[] = {
+    {Py_tp_traverse, send_zc_traverse_impl},
+    {Py_tp_clear, send_zc_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_send_zc_operation_spec = {
+    .name      = "_impl._SendZcOperation",
+    .basicsize = sizeof(SendZcOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_send_zc_operation_slots,
+};
+
+PyTypeObject *send_zc_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_send_zc_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
@@ -4,13 +4,37 @@
 #pragma once
 
 #include "op/base.h"
+#include "util/iovec.h"
+
+#include <sys/socket.h>
 
 typedef struct {
     /* fd is stored in base.scratch */
     Operation base;
-    PyObject *buf;
+    Py_buffer view;
     int flags;
 } SendOperation;
 
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    Py_buffer view;
+    int flags;
+} SendZcOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    BufferVector vec;
+    struct msghdr msg;
+    int flags;
+} SendmsgOperation;
+
 PyObject *send_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 PyTypeObject *send_operation_register(PyObject *mod);
+
+PyObject *sendmsg_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *sendmsg_operation_register(PyObject *mod);
+
+PyObject *send_zc_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *send_zc_operation_register(PyObject *mod);
@@ -0,0 +1,243 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/sendfile.h"
+
+#include "util/python.h"
+
+#include <assert.h>
+#include <fcntl.h>
+
+#include "module.h"
+
+/* The most a single round moves, which matches the default pipe size. */
+#define SENDFILE_CHUNK (64 * 1024)
+
+/* The two linked submissions that make up a round. */
+typedef enum {
+    Leg_Fill,
+    Leg_Drain,
+} SendfileLeg;
+
+static inline uint64_t sendfile_leg_data(SendfileOperation *self, SendfileLeg leg) {
+    return proactor_tag(&self->base, PROACTOR_TAG_LEG + leg);
+}
+
+static bool sendfile_pump(SendfileOperation *self) {
+    struct io_uring_sqe *sqe;
+
+    if (!proactor_reserve(self->proactor, 2)) {
+        return false;
+    }
+
+    if (self->buffered > 0) {
+        /* The socket did not take everything, flush the rest. */
+        sqe = proactor_get_submission(self->proactor);
+        io_uring_prep_splice(sqe, self->pipe[0], -1, self->base.scratch, -1, self->buffered, SPLICE_F_MOVE);
+        io_uring_sqe_set_data64(sqe, sendfile_leg_data(self, Leg_Drain));
+        self->inflight = 1;
+        return true;
+    }
+
+    /*
+     * Splices from a regular file are only short at its end, which
+     * cancels the softly linked drain. That way, the drain never waits
+     * on an empty pipe for data that is not going to come.
+     */
+    self->chunk = self->remaining < SENDFILE_CHUNK ? (unsigned)self->remaining : SENDFILE_CHUNK;
+    self->cut   = false;
+
+    sqe = proactor_get_submission(self->proactor);
+    io_uring_prep_splice(sqe, self->in_fd, self->offset, self->pipe[1], -1, self->chunk, SPLICE_F_MOVE);
+    io_uring_sqe_set_data64(sqe, sendfile_leg_data(self, Leg_Fill));
+    sqe->flags |= IOSQE_IO_LINK;
+
+    sqe = proactor_get_submission(self->proactor);
+    io_uring_prep_splice(sqe, self->pipe[0], -1, self->base.scratch, -1, self->chunk, SPLICE_F_MOVE);
+    io_uring_sqe_set_data64(sqe, sendfile_leg_data(self, Leg_Drain));
+    self->inflight = 2;
+    return true;
+}
+
+static void sendfile_finish(SendfileOperation *self) {
+    pipe_pool_release(self->pipes, self->pipe, self->buffered == 0);
+
+    if (outcome_empty(&self->base.outcome)) {
+        if (self->error != 0) {
+            errno = self->error;
+            outcome_capture_errno(&self->base.outcome);
+        } else {
+            outcome_capture(&self->base.outcome, PyLong_FromUnsignedLongLong(self->total));
+        }
+    }
+
+    /* This tells the proactor to wake the awaiter and let go of us. */
+    self->base.inflight = false;
+}
+
+static void sendfile_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    (void)self;
+    (void)sqe;
+
+    /* Transfers are submitted via sendfile_operation_submit instead. */
+    Py_UNREACHABLE();
+}
+
+static void sendfile_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    SendfileOperation *op = (SendfileOperation *)self;
+    int res               = cqe->res;
+
+    assert(op->inflight > 0);
+    --op->inflight;
+
+    switch ((SendfileLeg)((io_uring_cqe_get_data64(cqe) & PROACTOR_TAG_MASK) - PROACTOR_TAG_LEG)) {
+    case Leg_Fill:
+        if (res > 0) {
+            op->buffered += res;
+            op->offset += res;
+            op->remaining -= res;
+        } else if (res == 0) {
+            /* The file ended before the requested range did. */
+            op->eof = true;
+        } else if (op->error == 0) {
+            op->error = -res;
+        }
+
+        op->cut = res != (int)op->chunk;
+        break;
+
+    case Leg_Drain:
+        if (res > 0) {
+            op->buffered -= res;
+            op->total += res;
+        } else if (res < 0 && !(res == -ECANCELED && op->cut) && op->error == 0) {
+            op->error = -res;
+        }
+        break;
+
+    default:
+        Py_UNREACHABLE();
+    }
+
+    if (op->inflight > 0) {
+        return;
+    }
+
+    if (op->error == 0 && (op->buffered > 0 || (op->remaining > 0 && !op->eof))) {
+        if (op->proactor->closing) {
+            op->error = ECANCELED;
+        } else if (sendfile_pump(op)) {
+            return;
+        } else {
+            outcome_capture_error(&op->base.outcome);
+        }
+    }
+
+    sendfile_finish(op);
+}
+
+static OperationVTable g_sendfile_operation_vtable = {
+    .prepare  = sendfile_prepare,
+    .complete = sendfile_complete,
+};
+
+PyObject *sendfile_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int out_fd;
+    if (!python_parse_int(&out_fd, args[0])) {
+        return NULL;
+    }
+
+    int in_fd;
+    if (!python_parse_int(&in_fd, args[1])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[2])) {
+        return NULL;
+    }
+
+    unsigned long long count;
+    if (!python_parse_unsigned_long_long(&count, args[3])) {
+        return NULL;
+    }
+
+    /* Splice offsets are signed, and an empty range has nothing to submit. */
+    if (offset > LLONG_MAX || count > LLONG_MAX - offset) {
+        PyErr_SetString(PyExc_OverflowError, "File range is too large");
+        return NULL;
+    }
+
+    if (count == 0) {
+        PyErr_SetString(PyExc_ValueError, "Cannot send an empty file range");
+        return NULL;
+    }
+
+    SendfileOperation *op = (SendfileOperation *)operation_alloc(state->SendfileOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable  = &g_sendfile_operation_vtable;
+        op->base.scratch = out_fd;
+        op->in_fd        = in_fd;
+        op->pipe[0]      = -1;
+        op->pipe[1]      = -1;
+        op->offset       = offset;
+        op->remaining    = count;
+        op->buffered     = 0;
+        op->chunk        = 0;
+        op->inflight     = 0;
+        op->cut          = false;
+        op->eof          = false;
+        op->error        = 0;
+        op->total        = 0;
+        op->proactor     = NULL;
+        op->pipes        = NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+int sendfile_operation_submit(SendfileOperation *self, Proactor *proactor, PipePool *pipes) {
+    if (!proactor_reserve(proactor, 2)) {
+        return -1;
+    }
+
+    if (!pipe_pool_acquire(pipes, self->pipe)) {
+        return -1;
+    }
+
+    self->proactor = proactor;
+    self->pipes    = pipes;
+
+    bool res = sendfile_pump(self);
+    assert(res);
+    (void)res;
+
+    self->base.inflight = true;
+    return 0;
+}
+
+static PyType_Slot g_sendfile_operation_slots[] = {
+    {0, NULL},
+};
+
+static PyType_Spec g_sendfile_operation_spec = {
+    .name      = "_impl._SendfileOperation",
+    .basicsize = sizeof(SendfileOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_sendfile_operation_slots,
+};
+
+PyTypeObject *sendfile_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_sendfile_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
@@ -0,0 +1,42 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "driver/pipes.h"
+#include "driver/proactor.h"
+#include "op/base.h"
+
+/*
+ * Streams a range of a file into a socket, like sendfile(2). Rounds
+ * of two linked splices move the data through a pipe from the runtime
+ * pool, and the operation completes once with the total byte count.
+ */
+typedef struct {
+    /* out_fd is stored in base.scratch */
+    Operation base;
+    int in_fd;
+    /* The read and write end of the pipe while in flight, -1 otherwise. */
+    int pipe[2];
+    unsigned long long offset;
+    unsigned long long remaining;
+    /* Bytes spliced into the pipe which did not reach the socket yet. */
+    unsigned buffered;
+    /* The length of the last fill, which decides whether its drain ran. */
+    unsigned chunk;
+    unsigned inflight;
+    bool cut;
+    bool eof;
+    /* The first error that stopped the transfer, as a positive errno. */
+    int error;
+    unsigned long long total;
+    Proactor *proactor;
+    PipePool *pipes;
+} SendfileOperation;
+
+PyObject *sendfile_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
+/* Acquires a pipe and submits the first round of the transfer. */
+int sendfile_operation_submit(SendfileOperation *self, Proactor *proactor, PipePool *pipes);
+
+PyTypeObject *sendfile_operation_register(PyObject *mod);
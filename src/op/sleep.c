@@ -0,0 +1,107 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/sleep.h"
+
+#include "util/python.h"
+
+#include <math.h>
+
+#include "module.h"
+
+static void sleep_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    (void)self;
+    (void)sqe;
+
+    /* Sleeps are tracked in the timer wheel and never reach the kernel. */
+    Py_UNREACHABLE();
+}
+
+static void sleep_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    (void)self;
+    (void)cqe;
+
+    Py_UNREACHABLE();
+}
+
+static OperationVTable g_sleep_operation_vtable = {
+    .prepare  = sleep_prepare,
+    .complete = sleep_complete,
+};
+
+static bool parse_seconds(double *out, PyObject *ob) {
+    double seconds = PyFloat_AsDouble(ob);
+    if (seconds == -1.0 && PyErr_Occurred()) {
+        return false;
+    }
+
+    /* Nanosecond deadlines must comfortably fit into 64 bits. */
+    if (!isfinite(seconds) || fabs(seconds) >= (double)LLONG_MAX / 1e9 / 2.0) {
+        PyErr_SetString(PyExc_ValueError, "Time must be a finite number of seconds");
+        return false;
+    }
+
+    *out = seconds;
+    return true;
+}
+
+static PyObject *sleep_operation_create_at(ImplState *state, double deadline_ns) {
+    SleepOperation *op = (SleepOperation *)operation_alloc(state->SleepOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable = &g_sleep_operation_vtable;
+
+        /*
+         * Round up to the millisecond resolution of the timer wheel so
+         * that we never wake up early. Deadlines in the past become 0,
+         * which always expires immediately.
+         */
+        op->entry.prev     = &op->entry;
+        op->entry.next     = &op->entry;
+        op->entry.deadline = deadline_ns > 0.0 ? (uint64_t)ceil(deadline_ns / 1e6) : 0;
+    }
+
+    return (PyObject *)op;
+}
+
+PyObject *sleep_operation_create(PyObject *mod, PyObject *seconds_) {
+    ImplState *state = PyModule_GetState(mod);
+
+    double seconds;
+    if (!parse_seconds(&seconds, seconds_)) {
+        return NULL;
+    }
+
+    if (seconds <= 0.0) {
+        return sleep_operation_create_at(state, 0.0);
+    }
+
+    return sleep_operation_create_at(state, (double)timer_clock_ns() + seconds * 1e9);
+}
+
+PyObject *sleep_until_operation_create(PyObject *mod, PyObject *deadline_) {
+    ImplState *state = PyModule_GetState(mod);
+
+    double deadline;
+    if (!parse_seconds(&deadline, deadline_)) {
+        return NULL;
+    }
+
+    return sleep_operation_create_at(state, deadline * 1e9);
+}
+
+static PyType_Slot g_sleep_operation_slots[] = {
+    {0, NULL},
+};
+
+static PyType_Spec g_sleep_operation_spec = {
+    .name      = "_impl._SleepOperation",
+    .basicsize = sizeof(SleepOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_sleep_operation_slots,
+};
+
+PyTypeObject *sleep_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_sleep_operation_spec, (PyObject *)state->Operation_type);
+}
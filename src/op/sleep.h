@@ -0,0 +1,21 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "driver/timer.h"
+#include "op/base.h"
+
+typedef struct {
+    Operation base;
+    /* Absolute deadline on the monotonic clock, in milliseconds. */
+    TimerEntry entry;
+} SleepOperation;
+
+static inline SleepOperation *sleep_operation_from_entry(TimerEntry *entry) {
+    return (SleepOperation *)((char *)entry - offsetof(SleepOperation, entry));
+}
+
+PyObject *sleep_operation_create(PyObject *mod, PyObject *seconds);
+PyObject *sleep_until_operation_create(PyObject *mod, PyObject *deadline);
+PyTypeObject *sleep_operation_register(PyObject *mod);
@@ -10,12 +10,22 @@
 static void socket_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     SocketOperation *op = (SocketOperation *)self;
 
-    io_uring_prep_socket(sqe, op->base.scratch, op->type, op->protocol, 0);
+    if (op->direct) {
+        io_uring_prep_socket_direct_alloc(sqe, op->base.scratch, op->type, op->protocol, 0);
+    } else {
+        io_uring_prep_socket(sqe, op->base.scratch, op->type, op->protocol, 0);
+    }
 }
 
 static void socket_complete(PyObject *self, struct io_uring_cqe *cqe) {
     Operation *op = (Operation *)self;
-    outcome_capture(&op->outcome, PyLong_FromLong(cqe->res));
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->outcome);
+    } else {
+        outcome_capture(&op->outcome, PyLong_FromLong(cqe->res));
+    }
 }
 
 static OperationVTable g_socket_operation_vtable = {
@@ -27,8 +37,8 @@ PyObject *socket_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 3) {
-        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -47,12 +57,18 @@ PyObject *socket_operation_create(PyObject *mod, PyObject *const *args, Py_ssize
         return NULL;
     }
 
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
     SocketOperation *op = (SocketOperation *)operation_alloc(state->SocketOperation_type, state);
     if (op != NULL) {
         op->base.vtable  = &g_socket_operation_vtable;
         op->base.scratch = domain;
         op->type         = type;
         op->protocol     = protocol;
+        op->direct       = direct;
     }
 
     return (PyObject *)op;
@@ -10,6 +10,7 @@ typedef struct {
     Operation base;
     int type;
     int protocol;
+    bool direct;
 } SocketOperation;
 
 PyObject *socket_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
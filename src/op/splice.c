@@ -0,0 +1,190 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "op/splice.h"
+
+#include "util/python.h"
+
+#include "module.h"
+
+static void splice_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    Operation *op = (Operation *)self;
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->outcome);
+    } else {
+        outcome_capture(&op->outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+/* SpliceOperation implementation */
+
+static void splice_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    SpliceOperation *op = (SpliceOperation *)self;
+
+    io_uring_prep_splice(sqe, op->fd_in, op->off_in, op->base.scratch, op->off_out, op->nbytes, op->flags);
+}
+
+static OperationVTable g_splice_operation_vtable = {
+    .prepare  = splice_prepare,
+    .complete = splice_complete,
+};
+
+static bool parse_offset(long long *out, PyObject *ob) {
+    long long off = PyLong_AsLongLong(ob);
+    if (off == -1 && PyErr_Occurred()) {
+        return false;
+    }
+
+    /* -1 uses and advances the file position, like a NULL offset to splice(2). */
+    if (off < -1) {
+        PyErr_SetString(PyExc_ValueError, "Offset must be non-negative or -1");
+        return false;
+    }
+
+    *out = off;
+    return true;
+}
+
+PyObject *splice_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 6) {
+        PyErr_Format(PyExc_TypeError, "Expected 6 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd_in;
+    if (!python_parse_int(&fd_in, args[0])) {
+        return NULL;
+    }
+
+    long long off_in;
+    if (!parse_offset(&off_in, args[1])) {
+        return NULL;
+    }
+
+    int fd_out;
+    if (!python_parse_int(&fd_out, args[2])) {
+        return NULL;
+    }
+
+    long long off_out;
+    if (!parse_offset(&off_out, args[3])) {
+        return NULL;
+    }
+
+    unsigned nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[4])) {
+        return NULL;
+    }
+
+    unsigned flags;
+    if (!python_parse_unsigned_int(&flags, args[5])) {
+        return NULL;
+    }
+
+    SpliceOperation *op = (SpliceOperation *)operation_alloc(state->SpliceOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable  = &g_splice_operation_vtable;
+        op->base.scratch = fd_out;
+        op->fd_in        = fd_in;
+        op->off_in       = off_in;
+        op->off_out      = off_out;
+        op->nbytes       = nbytes;
+        op->flags        = flags;
+    }
+
+    return (PyObject *)op;
+}
+
+static PyType_Slot g_splice_operation_slots[] = {
+    {0, NULL},
+};
+
+static PyType_Spec g_splice_operation_spec = {
+    .name      = "_impl._SpliceOperation",
+    .basicsize = sizeof(SpliceOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_splice_operation_slots,
+};
+
+PyTypeObject *splice_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_splice_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* TeeOperation implementation */
+
+static void tee_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    TeeOperation *op = (TeeOperation *)self;
+
+    io_uring_prep_tee(sqe, op->fd_in, op->base.scratch, op->nbytes, op->flags);
+}
+
+static OperationVTable g_tee_operation_vtable = {
+    .prepare  = tee_prepare,
+    .complete = splice_complete,
+};
+
+PyObject *tee_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd_in;
+    if (!python_parse_int(&fd_in, args[0])) {
+        return NULL;
+    }
+
+    int fd_out;
+    if (!python_parse_int(&fd_out, args[1])) {
+        return NULL;
+    }
+
+    unsigned nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[2])) {
+        return NULL;
+    }
+
+    unsigned flags;
+    if (!python_parse_unsigned_int(&flags, args[3])) {
+        return NULL;
+    }
+
+    TeeOperation *op = (TeeOperation *)operation_alloc(state->TeeOperation_type, state);
+    if (op != NULL) {
+        op->base.vtable  = &g_tee_operation_vtable;
+        op->base.scratch = fd_out;
+        op->fd_in        = fd_in;
+        op->nbytes       = nbytes;
+        op->flags        = flags;
+    }
+
+    return (PyObject *)op;
+}
+
+static PyType_Slot g_tee_operation_slots[] = {
+    {0, NULL},
+};
+
+static PyType_Spec g_tee_operation_spec = {
+    .name      = "_impl._TeeOperation",
+    .basicsize = sizeof(TeeOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_tee_operation_slots,
+};
+
+PyTypeObject *tee_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_tee_operation_spec, (PyObject *)state->Operation_type);
+}
@@ -0,0 +1,30 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "op/base.h"
+
+typedef struct {
+    /* fd_out is stored in base.scratch */
+    Operation base;
+    int fd_in;
+    long long off_in;
+    long long off_out;
+    unsigned nbytes;
+    unsigned flags;
+} SpliceOperation;
+
+typedef struct {
+    /* fd_out is stored in base.scratch */
+    Operation base;
+    int fd_in;
+    unsigned nbytes;
+    unsigned flags;
+} TeeOperation;
+
+PyObject *splice_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *splice_operation_register(PyObject *mod);
+
+PyObject *tee_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *tee_operation_register(PyObject *mod);
@@ -5,19 +5,22 @@
 
 #include "util/python.h"
 
+#include "driver/buffers.h"
 #include "module.h"
 
+/* WriteOperation implementation */
+
 static void write_prepare(PyObject *self, struct io_uring_sqe *sqe) {
     WriteOperation *op = (WriteOperation *)self;
 
-    char *buf     = PyBytes_AS_STRING(op->buf);
-    size_t nbytes = PyBytes_Size(op->buf);
-    io_uring_prep_write(sqe, op->base.scratch, buf, nbytes, op->offset);
+    io_uring_prep_write(sqe, op->base.scratch, op->view.buf, op->view.len, op->offset);
 }
 
 static void write_complete(PyObject *self, struct io_uring_cqe *cqe) {
     WriteOperation *op = (WriteOperation *)self;
 
+    python_release_buffer(&op->view);
+
     if (cqe->res < 0) {
         errno = -cqe->res;
         outcome_capture_errno(&(op->base.outcome));
@@ -35,8 +38,8 @@ PyObject *write_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_
     ImplState *state = PyModule_GetState(mod);
 
     Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
-    if (nargs != 3) {
-        PyErr_Format(PyExc_TypeError, "Expected 3 arguments, got %zu instead", nargs);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
         return NULL;
     }
 
@@ -45,23 +48,33 @@ PyObject *write_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_
         return NULL;
     }
 
-    PyObject *buf = args[1];
-    if (!PyBytes_Check(buf)) {
-        PyErr_Format(PyExc_TypeError, "Expected variable of type bytes");
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[2])) {
         return NULL;
     }
 
-    unsigned long long offset;
-    if (!python_parse_unsigned_long_long(&offset, args[2])) {
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
         return NULL;
     }
 
     WriteOperation *op = (WriteOperation *)operation_alloc(state->WriteOperation_type, state);
-    if (op != NULL) {
-        op->base.vtable  = &g_write_operation_vtable;
-        op->base.scratch = fd;
-        op->buf          = Py_NewRef(buf);
-        op->offset       = offset;
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_write_operation_vtable;
+    op->base.scratch   = fd;
+    op->offset         = offset;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /*
+     * Writing straight from the exported buffer avoids a copy into a
+     * bytes object. The export stays locked until the write completed.
+     */
+    if (!python_get_buffer(&op->view, args[1], false, 0)) {
+        Py_DECREF(op);
+        return NULL;
     }
 
     return (PyObject *)op;
@@ -71,14 +84,14 @@ static int write_traverse_impl(PyObject *self, visitproc visit, void *arg) {
     WriteOperation *op = (WriteOperation *)self;
 
     Py_VISIT(Py_TYPE(self));
-    Py_VISIT(op->buf);
+    Py_VISIT(op->view.obj);
     return operation_traverse(&op->base, visit, arg);
 }
 
 static int write_clear_impl(PyObject *self) {
     WriteOperation *op = (WriteOperation *)self;
 
-    Py_CLEAR(op->buf);
+    python_release_buffer(&op->view);
     return operation_clear(&op->base);
 }
 
@@ -100,3 +113,223 @@ PyTypeObject *write_operation_register(PyObject *mod) {
     ImplState *state = PyModule_GetState(mod);
     return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_write_operation_spec, (PyObject *)state->Operation_type);
 }
+
+/* WritevOperation implementation */
+
+static void writev_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    WritevOperation *op = (WritevOperation *)self;
+
+    io_uring_prep_writev(sqe, op->base.scratch, op->vec.iov, op->vec.count, op->offset);
+}
+
+static void writev_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    WritevOperation *op = (WritevOperation *)self;
+
+    buffer_vector_release(&op->vec);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_writev_operation_vtable = {
+    .prepare  = writev_prepare,
+    .complete = writev_complete,
+};
+
+PyObject *writev_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 3 && nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 3 or 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[2])) {
+        return NULL;
+    }
+
+    bool direct = false;
+    if (nargs == 4 && !python_parse_bool(&direct, args[3])) {
+        return NULL;
+    }
+
+    WritevOperation *op = (WritevOperation *)operation_alloc(state->WritevOperation_type, state);
+    if (op == NULL) {
+        return NULL;
+    }
+
+    op->base.vtable    = &g_writev_operation_vtable;
+    op->base.scratch   = fd;
+    op->offset         = offset;
+    op->base.sqe_flags = direct ? IOSQE_FIXED_FILE : 0;
+
+    /* All buffers stay locked until the write completed. */
+    if (!buffer_vector_init(&op->vec, args[1], false)) {
+        Py_DECREF(op);
+        return NULL;
+    }
+
+    return (PyObject *)op;
+}
+
+static int writev_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    WritevOperation *op = (WritevOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+
+    int res = buffer_vector_traverse(&op->vec, visit, arg);
+    if (res != 0) {
+        return res;
+    }
+
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int writev_clear_impl(PyObject *self) {
+    WritevOperation *op = (WritevOperation *)self;
+
+    buffer_vector_release(&op->vec);
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_writev_operation_slots[] = {
+    {Py_tp_traverse, writev_traverse_impl},
+    {Py_tp_clear, writev_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_writev_operation_spec = {
+    .name      = "_impl._WritevOperation",
+    .basicsize = sizeof(WritevOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_writev_operation_slots,
+};
+
+PyTypeObject *writev_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_writev_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
+
+/* WriteFixedOperation implementation */
+
+static void write_fixed_prepare(PyObject *self, struct io_uring_sqe *sqe) {
+    WriteFixedOperation *op = (WriteFixedOperation *)self;
+
+    io_uring_prep_write_fixed(sqe, op->base.scratch, op->buf->data, op->nbytes, op->offset, op->buf->bid);
+}
+
+static void write_fixed_complete(PyObject *self, struct io_uring_cqe *cqe) {
+    WriteFixedOperation *op = (WriteFixedOperation *)self;
+
+    /* The kernel is done with the buffer, so Python code may release it again. */
+    fixed_buffer_unpin(op->buf);
+    Py_CLEAR(op->buf);
+
+    if (cqe->res < 0) {
+        errno = -cqe->res;
+        outcome_capture_errno(&op->base.outcome);
+    } else {
+        outcome_capture(&op->base.outcome, PyLong_FromLong(cqe->res));
+    }
+}
+
+static OperationVTable g_write_fixed_operation_vtable = {
+    .prepare  = write_fixed_prepare,
+    .complete = write_fixed_complete,
+};
+
+PyObject *write_fixed_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 4) {
+        PyErr_Format(PyExc_TypeError, "Expected 4 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    int fd;
+    if (!python_parse_int(&fd, args[0])) {
+        return NULL;
+    }
+
+    unsigned int nbytes;
+    if (!python_parse_unsigned_int(&nbytes, args[2])) {
+        return NULL;
+    }
+
+    unsigned long long offset;
+    if (!python_parse_unsigned_long_long(&offset, args[3])) {
+        return NULL;
+    }
+
+    LeasedBuffer *buf = fixed_buffer_pin(state, args[1], nbytes);
+    if (buf == NULL) {
+        return NULL;
+    }
+
+    WriteFixedOperation *op = (WriteFixedOperation *)operation_alloc(state->WriteFixedOperation_type, state);
+    if (op == NULL) {
+        fixed_buffer_unpin(buf);
+        Py_DECREF(buf);
+        return NULL;
+    }
+
+    op->base.vtable  = &g_write_fixed_operation_vtable;
+    op->base.scratch = fd;
+    op->buf          = buf;
+    op->nbytes       = nbytes;
+    op->offset       = offset;
+
+    return (PyObject *)op;
+}
+
+static int write_fixed_traverse_impl(PyObject *self, visitproc visit, void *arg) {
+    WriteFixedOperation *op = (WriteFixedOperation *)self;
+
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(op->buf);
+    return operation_traverse(&op->base, visit, arg);
+}
+
+static int write_fixed_clear_impl(PyObject *self) {
+    WriteFixedOperation *op = (WriteFixedOperation *)self;
+
+    if (op->buf != NULL) {
+        fixed_buffer_unpin(op->buf);
+        Py_CLEAR(op->buf);
+    }
+    return operation_clear(&op->base);
+}
+
+static PyType_Slot g_write_fixed_operation_slots[] = {
+    {Py_tp_traverse, write_fixed_traverse_impl},
+    {Py_tp_clear, write_fixed_clear_impl},
+    {0, NULL},
+};
+
+static PyType_Spec g_write_fixed_operation_spec = {
+    .name      = "_impl._WriteFixedOperation",
+    .basicsize = sizeof(WriteFixedOperation),
+    .itemsize  = 0,
+    .flags     = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_IMMUTABLETYPE,
+    .slots     = g_write_fixed_operation_slots,
+};
+
+PyTypeObject *write_fixed_operation_register(PyObject *mod) {
+    ImplState *state = PyModule_GetState(mod);
+    return (PyTypeObject *)PyType_FromModuleAndSpec(mod, &g_write_fixed_operation_spec,
+                                                    (PyObject *)state->Operation_type);
+}
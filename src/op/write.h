@@ -3,14 +3,37 @@
 
 #pragma once
 
+#include "driver/buffers.h"
 #include "op/base.h"
+#include "util/iovec.h"
 
 typedef struct {
     /* fd is stored in base.scratch */
     Operation base;
-    PyObject *buf;
+    Py_buffer view;
     unsigned long long offset;
 } WriteOperation;
 
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    LeasedBuffer *buf;
+    unsigned int nbytes;
+    unsigned long long offset;
+} WriteFixedOperation;
+
+typedef struct {
+    /* fd is stored in base.scratch */
+    Operation base;
+    BufferVector vec;
+    unsigned long long offset;
+} WritevOperation;
+
 PyObject *write_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargs);
 PyTypeObject *write_operation_register(PyObject *mod);
+
+PyObject *writev_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *writev_operation_register(PyObject *mod);
+
+PyObject *write_fixed_operation_create(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+PyTypeObject *write_fixed_operation_register(PyObject *mod);
@@ -3,6 +3,9 @@
 
 #include "run.h"
 
+#include "channel.h"
+#include "driver/scheduler.h"
+
 static const char g_bad_yield_value_fmt[] = "Event loop received unrecognized yield value: %R. In case "
                                             "you're trying to use a library written for a different "
                                             "framework like asyncio, this will not work directly.";
@@ -30,6 +33,27 @@ static void close_coro(PyObject *coro) {
     Py_XDECREF(res);
 }
 
+static int event_loop_join(RunState *rs, Task *task, Task *waiter) {
+#ifdef Py_GIL_DISABLED
+    if (rs->rt->worker != NULL) {
+        return scheduler_join(rs->rt->worker, task, waiter);
+    }
+#endif
+
+    return task_join(task, waiter, &rs->rt->run_queue);
+}
+
+static void event_loop_finish_task(RunState *rs, Task *task, PyObject *result) {
+#ifdef Py_GIL_DISABLED
+    if (rs->rt->worker != NULL) {
+        scheduler_finish(rs->rt->worker, task, result);
+        return;
+    }
+#endif
+
+    task_finish(task, result, &rs->rt->run_queue);
+}
+
 static LoopStatus event_loop_handle_yield(RunState *rs, Task *task, PyObject *value) {
     if (PyObject_TypeCheck(value, rs->state->Operation_type) != 0) {
         /*
@@ -43,6 +67,31 @@ static LoopStatus event_loop_handle_yield(RunState *rs, Task *task, PyObject *va
             return LOOP_ERROR;
         }
 
+        return LOOP_CONTINUE;
+    } else if (PyObject_TypeCheck(value, rs->state->Task_type) != 0) {
+        /*
+         * Awaiting another task parks this one on its waiter list until
+         * it finishes. The waiter list holds its own reference.
+         */
+        int rc = event_loop_join(rs, (Task *)value, task);
+        Py_DECREF(value);
+        return rc == 0 ? LOOP_CONTINUE : LOOP_ERROR;
+    } else if (PyObject_TypeCheck(value, rs->state->Channel_type) != 0) {
+        /*
+         * Receiving from an empty channel waits for the next message.
+         * Messages arrive on this ring, so the task stays on this worker.
+         */
+        if (rs->rt->worker != NULL) {
+            task->home = rs->rt->worker;
+        }
+
+        channel_park((Channel *)value, rs->rt, task);
+        Py_DECREF(value);
+        return LOOP_CONTINUE;
+    } else if (Py_IsNone(value)) {
+        /* A bare yield gives the other tasks a turn before resuming. */
+        task_list_push_back(&rs->rt->run_queue, task);
+        Py_DECREF(value);
         return LOOP_CONTINUE;
     } else {
         PyErr_Format(PyExc_RuntimeError, g_bad_yield_value_fmt, value);
@@ -56,7 +105,7 @@ static LoopStatus event_loop_handle_return(RunState *rs, Task *task, PyObject *v
         rs->result = value;
         return LOOP_DONE;
     } else {
-        Py_XDECREF(value);
+        event_loop_finish_task(rs, task, value);
         return LOOP_CONTINUE;
     }
 }
@@ -65,13 +114,15 @@ static LoopStatus event_loop_handle_error(RunState *rs, Task *task) {
     if (task == rs->root) {
         return LOOP_ERROR;
     } else {
-        PyErr_WriteUnraisable((PyObject *)task);
+        /* The exception is raised in whoever awaits the task, if anyone. */
+        event_loop_finish_task(rs, task, NULL);
         return LOOP_CONTINUE;
     }
 }
 
 int event_loop_init(RunState *rs, PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
     rs->state  = PyModule_GetState(mod);
+    rs->config = NULL;
     rs->rt     = NULL;
     rs->root   = NULL;
     rs->result = NULL;
@@ -101,7 +152,18 @@ int event_loop_init(RunState *rs, PyObject *mod, PyObject *const *args, Py_ssize
         return -1;
     }
 
-    rs->rt = runtime_enter(rs->state, (RunConfig *)args[1]);
+    rs->config = (RunConfig *)args[1];
+    if (rs->config->workers == 0) {
+        PyErr_SetString(PyExc_ValueError, "RunConfig.workers must be at least 1");
+        return -1;
+    }
+
+    /* The workers of the multi-threaded flavor enter runtimes of their own. */
+    if (rs->config->workers > 1) {
+        return 0;
+    }
+
+    rs->rt = runtime_enter(rs->state, rs->config);
     if (rs->rt == NULL) {
         return -1;
     }
@@ -122,21 +184,37 @@ void event_loop_finish(RunState *rs) {
     }
 }
 
-LoopStatus event_loop_run_step(RunState *rs) {
+LoopStatus event_loop_run_tasks(RunState *rs) {
     RuntimeHandle *rt = rs->rt;
     TaskList ready;
     LoopStatus status;
     PyObject *out;
 
     /*
-     * Process all runnable tasks which are ready in the current loop
+     * Process the runnable tasks which are ready in the current loop
      * step. Tasks that only become ready during this cycle as a result
      * of running another task will need to wait for the next round.
+     *
+     * The budget caps how many tasks run before the loop goes back to
+     * the ring, so a burst of ready tasks does not hold up submitting
+     * their operations and reaping new completions. The rest of the
+     * tasks keep their place at the front of the run queue.
      */
+    unsigned budget = rt->step_budget;
+
     task_list_move(&ready, &rt->run_queue);
+    runtime_drain_lifo(rt, &ready);
     while (!task_list_empty(&ready)) {
+        if (rt->step_budget != 0 && budget-- == 0) {
+            task_list_prepend(&rt->run_queue, &ready);
+            break;
+        }
+
         Task *task = task_list_pop_front(&ready);
 
+        /* Every resume starts with a fresh cooperative budget. */
+        rt->coop_remaining = rt->task_budget;
+
         switch (PyIter_Send(task->coro, Py_None, &out)) {
         case PYGEN_NEXT:
             status = event_loop_handle_yield(rs, task, out);
@@ -160,17 +238,52 @@ LoopStatus event_loop_run_step(RunState *rs) {
         }
     }
 
-    if (rt->proactor.pending_events == 0 && task_list_empty(&rt->run_queue)) {
+    return LOOP_CONTINUE;
+}
+
+LoopStatus event_loop_run_step(RunState *rs) {
+    RuntimeHandle *rt = rs->rt;
+
+    LoopStatus status = event_loop_run_tasks(rs);
+    if (status != LOOP_CONTINUE) {
+        return status;
+    }
+
+    bool has_timers = !timer_wheel_empty(&rt->timers);
+    bool has_ready = !task_list_empty(&rt->run_queue) || rt->lifo_slot != NULL;
+    /* Tasks waiting on a channel wait for messages from other threads. */
+    bool has_waiters = rt->channel_waiters > 0;
+    if (rt->proactor.pending_events == 0 && !has_timers && !has_ready && !has_waiters) {
         PyErr_SetString(PyExc_RuntimeError, "Deadlock: no pending events and no ready tasks");
         return LOOP_ERROR;
     }
 
-    if (rt->proactor.pending_events > 0) {
-        if (proactor_run(&rt->proactor, &rt->run_queue, 0) != 0) {
+    /*
+     * Only block in the kernel when there is nothing else to do, and
+     * never for longer than it takes until the nearest timer expires.
+     */
+    long long timeout = -1;
+    if (has_ready) {
+        timeout = 0;
+    } else if (has_timers) {
+        timeout = runtime_next_timeout(rt);
+    }
+
+    if (rt->proactor.pending_events > 0 || has_waiters || timeout > 0) {
+        TaskList woken;
+        task_list_init(&woken);
+
+        int res = proactor_run(&rt->proactor, &woken, timeout);
+        runtime_wake(rt, &woken);
+        if (res != 0) {
             return LOOP_ERROR;
         }
     }
 
+    if (has_timers) {
+        runtime_fire_timers(rt);
+    }
+
     return LOOP_CONTINUE;
 }
 
@@ -195,7 +308,7 @@ PyObject *event_loop_run(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf
         return NULL;
     }
 
-    LoopStatus s = event_loop_run_loop(&rs);
+    LoopStatus s = rs.rt != NULL ? event_loop_run_loop(&rs) : scheduler_run(&rs);
     event_loop_finish(&rs);
 
     if (s == LOOP_DONE) {
@@ -1,6 +1,8 @@
 /* This source file is part of the boros project. */
 /* SPDX-License-Identifier: ISC */
 
+#pragma once
+
 #include "util/python.h"
 
 #include "driver/handle.h"
@@ -9,6 +11,7 @@
 
 typedef struct {
     ImplState *state;
+    RunConfig *config;
     RuntimeHandle *rt;
     Task *root;
     PyObject *result;
@@ -23,6 +26,12 @@ typedef enum {
 int event_loop_init(RunState *rs, PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
 void event_loop_finish(RunState *rs);
 
+/*
+ * Resumes the tasks that are ready at the start of the step, bounded by
+ * the step budget. Leaves servicing the ring to the caller.
+ */
+LoopStatus event_loop_run_tasks(RunState *rs);
+
 LoopStatus event_loop_run_step(RunState *rs);
 LoopStatus event_loop_run_loop(RunState *rs);
 
@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <stddef.h>
 
+#include "driver/handle.h"
 #include "module.h"
 
 static inline void task_link_init(TaskLink *self) {
@@ -64,6 +65,36 @@ void task_list_move(TaskList *dst, TaskList *src) {
     task_list_init(src);
 }
 
+void task_list_append(TaskList *dst, TaskList *src) {
+    if (task_list_empty(src)) {
+        return;
+    }
+
+    TaskLink *first = src->head.next;
+    TaskLink *last  = src->head.prev;
+
+    first->prev          = dst->head.prev;
+    dst->head.prev->next = first;
+    last->next           = &dst->head;
+    dst->head.prev       = last;
+    task_list_init(src);
+}
+
+void task_list_prepend(TaskList *dst, TaskList *src) {
+    if (task_list_empty(src)) {
+        return;
+    }
+
+    TaskLink *first = src->head.next;
+    TaskLink *last  = src->head.prev;
+
+    last->next           = dst->head.next;
+    dst->head.next->prev = last;
+    first->prev          = &dst->head;
+    dst->head.next       = first;
+    task_list_init(src);
+}
+
 Task *task_list_back(TaskList *self) {
     return (Task *)((uint8_t *)(self->head.prev) - offsetof(Task, link));
 }
@@ -94,6 +125,34 @@ Task *task_list_pop_front(TaskList *self) {
     return task;
 }
 
+void task_list_split(TaskList *self, TaskList *dst) {
+    TaskList tail;
+    size_t count = 0;
+
+    for (TaskLink *link = self->head.next; link != &self->head; link = link->next) {
+        ++count;
+    }
+
+    task_list_init(&tail);
+
+    /* Walk backwards and keep the order of the tasks we take. */
+    TaskLink *link = self->head.prev;
+    for (size_t n = count / 2; n > 0 && link != &self->head;) {
+        TaskLink *prev = link->prev;
+        Task *task     = (Task *)((uint8_t *)link - offsetof(Task, link));
+
+        if (task->home == NULL) {
+            task_link_unlink(link);
+            task_link_link_next(&tail.head, link);
+            --n;
+        }
+
+        link = prev;
+    }
+
+    task_list_append(dst, &tail);
+}
+
 void task_list_remove(TaskList *self, Task *task) {
     (void)self;
 
@@ -105,7 +164,8 @@ void task_list_remove(TaskList *self, Task *task) {
 
 void task_list_clear(TaskList *self) {
     while (!task_list_empty(self)) {
-        task_list_pop_front(self);
+        Task *task = task_list_pop_front(self);
+        Py_DECREF(task);
     }
 }
 
@@ -115,13 +175,78 @@ Task *task_create(PyObject *mod, PyObject *name, PyObject *coro) {
     Task *task = (Task *)python_alloc(state->Task_type);
     if (task != NULL) {
         task_link_init(&task->link);
-        task->name = Py_XNewRef(name);
-        task->coro = Py_XNewRef(coro);
+        task_list_init(&task->waiters);
+        task->name      = Py_XNewRef(name);
+        task->coro      = Py_XNewRef(coro);
+        task->result    = NULL;
+        task->exception = NULL;
+        task->done      = false;
+        task->joined    = false;
+        task->home      = NULL;
     }
 
     return task;
 }
 
+PyObject *task_spawn(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf) {
+    ImplState *state = PyModule_GetState(mod);
+
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    if (nargs != 1 && nargs != 2) {
+        PyErr_Format(PyExc_TypeError, "Expected 1 or 2 arguments, got %zu instead", nargs);
+        return NULL;
+    }
+
+    PyObject *coro = args[0];
+    if (!PyCoro_CheckExact(coro)) {
+        PyErr_SetString(PyExc_TypeError, "Expected coroutine object");
+        return NULL;
+    }
+
+    PyObject *name = nargs == 2 ? args[1] : Py_None;
+
+    RuntimeHandle *rt = runtime_get_local(state);
+    if (rt == NULL) {
+        return NULL;
+    }
+
+    Task *task = task_create(mod, name, coro);
+    if (task != NULL) {
+        task_list_push_back(&rt->run_queue, task);
+    }
+
+    return (PyObject *)task;
+}
+
+void task_finish(Task *self, PyObject *result, TaskList *run_queue) {
+    assert(!self->done);
+
+    if (result != NULL) {
+        self->result = result;
+    } else {
+        self->exception = PyErr_GetRaisedException();
+    }
+
+    /* Every task that awaited the outcome can run again. */
+    __atomic_store_n(&self->done, true, __ATOMIC_RELEASE);
+    task_list_append(run_queue, &self->waiters);
+}
+
+int task_join(Task *self, Task *waiter, TaskList *run_queue) {
+    if (self == waiter) {
+        PyErr_SetString(PyExc_RuntimeError, "Task cannot await itself");
+        return -1;
+    }
+
+    if (task_done(self)) {
+        task_list_push_back(run_queue, waiter);
+    } else {
+        task_list_push_back(&self->waiters, waiter);
+    }
+
+    return 0;
+}
+
 PyDoc_STRVAR(g_task_doc, "A lightweight, concurrent thread of execution.\n\n"
                          "Tasks are similar to OS threads, but they are managed by the boros "
                          "scheduler\n"
@@ -133,6 +258,7 @@ PyDoc_STRVAR(g_task_doc, "A lightweight, concurrent thread of execution.\n\n"
 
 PyDoc_STRVAR(g_task_name_doc, "A string representation of the task name.");
 PyDoc_STRVAR(g_task_coro_doc, "The coroutine object associated with the task.");
+PyDoc_STRVAR(g_task_done_doc, "Whether the coroutine of the task has finished.");
 
 static PyObject *task_repr(PyObject *self) {
     Task *task = (Task *)self;
@@ -145,17 +271,95 @@ static int task_traverse(PyObject *self, visitproc visit, void *arg) {
     Py_VISIT(Py_TYPE(self));
     Py_VISIT(task->name);
     Py_VISIT(task->coro);
+    Py_VISIT(task->result);
+    Py_VISIT(task->exception);
+
+    for (TaskLink *link = task->waiters.head.next; link != &task->waiters.head; link = link->next) {
+        Py_VISIT((PyObject *)((uint8_t *)link - offsetof(Task, link)));
+    }
+
     return 0;
 }
 
 static int task_clear(PyObject *self) {
     Task *task = (Task *)self;
 
+    task_list_clear(&task->waiters);
     Py_CLEAR(task->name);
     Py_CLEAR(task->coro);
+    Py_CLEAR(task->result);
+    Py_CLEAR(task->exception);
     return 0;
 }
 
+static void task_finalize(PyObject *self) {
+    Task *task = (Task *)self;
+
+    /* Nobody is ever going to see the exception, so report it now. */
+    if (task->exception != NULL && !task->joined) {
+        PyObject *exc = PyErr_GetRaisedException();
+
+        PyErr_SetRaisedException(Py_NewRef(task->exception));
+        PyErr_WriteUnraisable(self);
+        PyErr_SetRaisedException(exc);
+    }
+}
+
+static void task_dealloc(PyObject *self) {
+    if (PyObject_CallFinalizerFromDealloc(self) < 0) {
+        return;
+    }
+
+    python_tp_dealloc(self);
+}
+
+static PySendResult task_send(PyObject *self, PyObject *arg, PyObject **presult) {
+    Task *task = (Task *)self;
+    (void)arg;
+
+    /*
+     * A task that is still running suspends the awaiter by yielding
+     * itself to the event loop, which parks the awaiter on the waiter
+     * list. Once resumed, the outcome is there, and every awaiter
+     * gets to see it.
+     */
+    if (!task_done(task)) {
+        *presult = Py_NewRef(self);
+        return PYGEN_NEXT;
+    }
+
+    /* Joining finished tasks in a loop must not starve the others. */
+    if (!runtime_coop_consume(PyType_GetModuleState(Py_TYPE(self)))) {
+        *presult = Py_NewRef(Py_None);
+        return PYGEN_NEXT;
+    }
+
+    task->joined = true;
+
+    if (task->exception != NULL) {
+        PyErr_SetRaisedException(Py_NewRef(task->exception));
+        *presult = NULL;
+        return PYGEN_ERROR;
+    }
+
+    *presult = Py_NewRef(task->result);
+    return PYGEN_RETURN;
+}
+
+static PyObject *task_iternext(PyObject *self) {
+    PyObject *res;
+
+    switch (task_send(self, Py_None, &res)) {
+    case PYGEN_NEXT:
+        return res;
+    case PYGEN_RETURN:
+        python_stop_iteration(res);
+        return NULL;
+    default:
+        return NULL;
+    }
+}
+
 static PyObject *task_name_get(PyObject *self, void *Py_UNUSED(closure)) {
     Task *task = (Task *)self;
     assert(task->name != NULL);
@@ -168,9 +372,15 @@ static PyObject *task_coro_get(PyObject *self, void *Py_UNUSED(closure)) {
     return Py_NewRef(task->coro);
 }
 
+static PyObject *task_done_get(PyObject *self, void *Py_UNUSED(closure)) {
+    Task *task = (Task *)self;
+    return PyBool_FromLong(task_done(task));
+}
+
 static PyGetSetDef g_task_properties[] = {
     {"name", task_name_get, NULL, g_task_name_doc, NULL},
     {"coro", task_coro_get, NULL, g_task_coro_doc, NULL},
+    {"done", task_done_get, NULL, g_task_done_doc, NULL},
     {NULL, NULL, NULL, NULL, NULL},
 };
 
@@ -179,10 +389,15 @@ static PyGetSetDef g_task_properties[] = {
 static PyType_Slot g_task_slots[] = {
     {Py_tp_doc, (void *)g_task_doc},
     {Py_tp_repr, task_repr},
-    {Py_tp_dealloc, python_tp_dealloc},
+    {Py_tp_finalize, task_finalize},
+    {Py_tp_dealloc, task_dealloc},
     {Py_tp_traverse, task_traverse},
     {Py_tp_clear, task_clear},
     {Py_tp_getset, g_task_properties},
+    {Py_tp_iter, PyObject_SelfIter},
+    {Py_tp_iternext, task_iternext},
+    {Py_am_await, PyObject_SelfIter},
+    {Py_am_send, task_send},
     {0, NULL},
 };
 // clang-format on
@@ -16,12 +16,28 @@ typedef struct {
     TaskLink head;
 } TaskList;
 
+struct _Worker;
+
 /* A concurrent thread of execution. */
 typedef struct {
     PyObject_HEAD
     TaskLink link;
     PyObject *name;
     PyObject *coro;
+    /* Tasks suspended until this one finishes, linked through their link. */
+    TaskList waiters;
+    /* The return value or exception of the coroutine once done. */
+    PyObject *result;
+    PyObject *exception;
+    bool done;
+    /* Whether anyone awaited the outcome, so lost exceptions get reported. */
+    bool joined;
+    /*
+     * The worker of a multi-threaded runtime the task is bound to, since
+     * completions for it keep arriving on that worker's ring. Unbound
+     * tasks may be stolen by any worker.
+     */
+    struct _Worker *home;
 } Task;
 
 /* TaskList API */
@@ -35,6 +51,10 @@ bool task_list_empty(TaskList *self);
 /* Moves all elements from src into dst. */
 void task_list_move(TaskList *dst, TaskList *src);
 
+/* Moves all elements from src to the back or front of dst. */
+void task_list_append(TaskList *dst, TaskList *src);
+void task_list_prepend(TaskList *dst, TaskList *src);
+
 /* Getters for back and front element of the list. */
 Task *task_list_back(TaskList *self);
 Task *task_list_front(TaskList *self);
@@ -47,6 +67,12 @@ void task_list_push_front(TaskList *self, Task *task);
 Task *task_list_pop_back(TaskList *self);
 Task *task_list_pop_front(TaskList *self);
 
+/*
+ * Moves up to half of the tasks in self, taken from the back, to the
+ * back of dst. Tasks bound to a worker stay where they are.
+ */
+void task_list_split(TaskList *self, TaskList *dst);
+
 /* Removes a given element that is currently in the list. */
 void task_list_remove(TaskList *self, Task *task);
 void task_list_clear(TaskList *self);
@@ -55,4 +81,30 @@ void task_list_clear(TaskList *self);
 
 Task *task_create(PyObject *mod, PyObject *name, PyObject *coro);
 
+/*
+ * Creates a task for coro and schedules it on the runtime of the
+ * current thread. Its handle can be awaited for the result.
+ */
+PyObject *task_spawn(PyObject *mod, PyObject *const *args, Py_ssize_t nargsf);
+
+/*
+ * Stores the outcome of the coroutine and moves all tasks waiting for
+ * it to the back of run_queue. With a NULL result, the currently
+ * raised exception is stored instead.
+ */
+void task_finish(Task *self, PyObject *result, TaskList *run_queue);
+
+/* Checks if the coroutine of the task has finished. */
+static inline bool task_done(Task *self) {
+    /* Pairs with the store in task_finish, which may run on another worker. */
+    return __atomic_load_n(&self->done, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Suspends waiter until self finished. When another worker finished
+ * self in the meantime, waiter goes to the back of run_queue instead.
+ * Fails for a task joining itself.
+ */
+int task_join(Task *self, Task *waiter, TaskList *run_queue);
+
 PyTypeObject *task_register(PyObject *mod);
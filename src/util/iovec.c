@@ -0,0 +1,71 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#include "util/iovec.h"
+
+#include <limits.h>
+
+bool buffer_vector_init(BufferVector *self, PyObject *ob, bool writable) {
+    self->iov   = NULL;
+    self->views = NULL;
+    self->count = 0;
+
+    PyObject *seq = PySequence_Fast(ob, "Expected a sequence of buffer objects");
+    if (seq == NULL) {
+        return false;
+    }
+
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    if (n == 0 || n > IOV_MAX) {
+        PyErr_Format(PyExc_ValueError, "Expected between 1 and %d buffers, got %zd", IOV_MAX, n);
+        Py_DECREF(seq);
+        return false;
+    }
+
+    /* Both arrays share one allocation, the views come second. */
+    char *mem = PyMem_Malloc(n * (sizeof(struct iovec) + sizeof(Py_buffer)));
+    if (mem == NULL) {
+        PyErr_NoMemory();
+        Py_DECREF(seq);
+        return false;
+    }
+
+    self->iov   = (struct iovec *)mem;
+    self->views = (Py_buffer *)(mem + n * sizeof(struct iovec));
+
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        Py_buffer *view = &self->views[i];
+        if (!python_get_buffer(view, items[i], writable, 0)) {
+            buffer_vector_release(self);
+            Py_DECREF(seq);
+            return false;
+        }
+
+        self->iov[i].iov_base = view->buf;
+        self->iov[i].iov_len  = view->len;
+        ++self->count;
+    }
+
+    Py_DECREF(seq);
+    return true;
+}
+
+void buffer_vector_release(BufferVector *self) {
+    for (size_t i = 0; i < self->count; ++i) {
+        python_release_buffer(&self->views[i]);
+    }
+
+    PyMem_Free(self->iov);
+    self->iov   = NULL;
+    self->views = NULL;
+    self->count = 0;
+}
+
+int buffer_vector_traverse(BufferVector *self, visitproc visit, void *arg) {
+    for (size_t i = 0; i < self->count; ++i) {
+        Py_VISIT(self->views[i].obj);
+    }
+
+    return 0;
+}
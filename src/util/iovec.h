@@ -0,0 +1,32 @@
+/* This source file is part of the boros project. */
+/* SPDX-License-Identifier: ISC */
+
+#pragma once
+
+#include "util/python.h"
+
+#include <sys/uio.h>
+
+/*
+ * An iovec array built from a sequence of Python buffer objects. The
+ * buffer exports are held until the vector is released, so the kernel
+ * may access the memory for as long as the submission is in flight.
+ */
+typedef struct {
+    struct iovec *iov;
+    Py_buffer *views;
+    size_t count;
+} BufferVector;
+
+/*
+ * Exports every buffer in the sequence ob. With writable, all buffers
+ * must accept writes. Raises ValueError for empty sequences or ones
+ * longer than IOV_MAX.
+ */
+bool buffer_vector_init(BufferVector *self, PyObject *ob, bool writable);
+
+/* Releases all buffer exports and the iovec array. */
+void buffer_vector_release(BufferVector *self);
+
+/* Garbage collection hook for the exporting objects. */
+int buffer_vector_traverse(BufferVector *self, visitproc visit, void *arg);
@@ -6,16 +6,91 @@
 #include <errno.h>
 #include <string.h>
 
+/*
+ * The low bits of Outcome.value tell what it holds. Results and errno
+ * values are tagged, untagged pointers are exception objects.
+ */
+#define TAG_MASK   3ULL
+#define TAG_RESULT 1ULL
+#define TAG_ERRNO  2ULL
+
 static inline PyObject *tag_pointer(PyObject *ob) {
-    return (PyObject *)((uintptr_t)ob | 1);
+    return (PyObject *)((uintptr_t)ob | TAG_RESULT);
 }
 
 static inline PyObject *untag_pointer(PyObject *ob) {
-    return (PyObject *)((uintptr_t)ob & ~1ULL);
+    return (PyObject *)((uintptr_t)ob & ~TAG_MASK);
 }
 
 static inline bool is_pointer_tagged(PyObject *ob) {
-    return ((uintptr_t)ob & 1) != 0;
+    return ((uintptr_t)ob & TAG_MASK) == TAG_RESULT;
+}
+
+static inline PyObject *tag_errno(int err) {
+    return (PyObject *)(((uintptr_t)(unsigned int)err << 2) | TAG_ERRNO);
+}
+
+static inline bool is_errno_tagged(PyObject *ob) {
+    return ((uintptr_t)ob & TAG_MASK) == TAG_ERRNO;
+}
+
+static inline int untag_errno(PyObject *ob) {
+    return (int)((uintptr_t)ob >> 2);
+}
+
+void errno_cache_clear(ErrnoCache *cache) {
+    for (size_t i = 0; i < ERRNO_CACHE_SIZE; ++i) {
+        Py_CLEAR(cache->messages[i]);
+    }
+}
+
+static PyObject *errno_cache_message(ErrnoCache *cache, int err) {
+    bool cacheable = err >= 0 && err < ERRNO_CACHE_SIZE;
+
+    if (cacheable) {
+        PyObject *cached = __atomic_load_n(&cache->messages[err], __ATOMIC_ACQUIRE);
+        if (cached != NULL) {
+            return Py_NewRef(cached);
+        }
+    }
+
+    PyObject *message = PyUnicode_DecodeLocale(strerror(err), "surrogateescape");
+    if (message != NULL && cacheable) {
+        /* Workers of the multi-threaded flavor may race to fill the slot. */
+        PyObject *expected = NULL;
+        if (__atomic_compare_exchange_n(&cache->messages[err], &expected, message, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE)) {
+            Py_INCREF(message);
+        }
+    }
+
+    return message;
+}
+
+/*
+ * Builds the exception for an errno value. Like PyErr_SetFromErrno,
+ * this goes through the OSError constructor which picks the matching
+ * subclass, e.g. ConnectionResetError for ECONNRESET.
+ */
+static PyObject *build_errno_exception(ErrnoCache *cache, int err) {
+    PyObject *error = PyLong_FromLong(err);
+    if (error == NULL) {
+        return NULL;
+    }
+
+    PyObject *message = errno_cache_message(cache, err);
+    if (message == NULL) {
+        Py_DECREF(error);
+        return NULL;
+    }
+
+    PyObject *args[3] = {NULL, error, message};
+    Py_ssize_t nargsf = 2 | PY_VECTORCALL_ARGUMENTS_OFFSET;
+
+    PyObject *exc = PyObject_Vectorcall(PyExc_OSError, args + 1, nargsf, NULL);
+    Py_DECREF(error);
+    Py_DECREF(message);
+    return exc;
 }
 
 void outcome_init(Outcome *outcome) {
@@ -27,14 +102,21 @@ bool outcome_empty(Outcome *outcome) {
 }
 
 int outcome_traverse(Outcome *outcome, visitproc visit, void *arg) {
+    if (is_errno_tagged(outcome->value)) {
+        return 0;
+    }
+
     PyObject *ob = untag_pointer(outcome->value);
     Py_VISIT(ob);
     return 0;
 }
 
 void outcome_clear(Outcome *outcome) {
-    PyObject *ob = untag_pointer(outcome->value);
-    Py_CLEAR(ob);
+    if (!is_errno_tagged(outcome->value)) {
+        PyObject *ob = untag_pointer(outcome->value);
+        Py_XDECREF(ob);
+    }
+
     outcome->value = NULL;
 }
 
@@ -59,47 +141,34 @@ void outcome_capture_error(Outcome *outcome) {
 }
 
 void outcome_capture_errno(Outcome *outcome) {
-    int e = errno;
-    PyObject *error;
-    PyObject *message = NULL;
-
-    error = PyLong_FromLong(e);
-    if (error == NULL) {
-        outcome_capture_error(outcome);
-        goto cleanup;
-    }
-
-    message = PyUnicode_DecodeLocale(strerror(e), "surrogateescape");
-    if (message == NULL) {
-        outcome_capture_error(outcome);
-        goto cleanup;
-    }
+    /*
+     * Failed completions are frequent and often expected, e.g. EAGAIN
+     * or ECANCELED. Defer building the OSError until someone asks.
+     */
+    outcome->value = tag_errno(errno);
+}
 
-    PyObject *args[3] = {NULL, error, message};
-    Py_ssize_t nargsf = 2 | PY_VECTORCALL_ARGUMENTS_OFFSET;
+PyObject *outcome_take(Outcome *outcome, ErrnoCache *cache) {
+    PyObject *value = outcome->value;
 
-    PyObject *exc = PyObject_Vectorcall(PyExc_OSError, args + 1, nargsf, NULL);
-    if (exc == NULL) {
-        outcome_capture_error(outcome);
-        goto cleanup;
+    outcome->value = NULL;
+    if (is_errno_tagged(value)) {
+        PyObject *exc = build_errno_exception(cache, untag_errno(value));
+        return exc != NULL ? exc : PyErr_GetRaisedException();
     }
 
-    outcome_store_error(outcome, exc);
-
-cleanup:
-    Py_XDECREF(error);
-    Py_XDECREF(message);
+    return untag_pointer(value);
 }
 
-PyObject *outcome_unwrap(Outcome *outcome) {
+PyObject *outcome_unwrap(Outcome *outcome, ErrnoCache *cache) {
     bool tagged  = is_pointer_tagged(outcome->value);
-    PyObject *ob = untag_pointer(outcome->value);
+    PyObject *ob = outcome_take(outcome, cache);
 
-    outcome->value = NULL;
     if (tagged) {
         return ob;
     } else if (PyErr_Occurred()) {
         PyErr_WriteUnraisable(ob);
+        Py_DECREF(ob);
         return NULL;
     } else {
         PyErr_SetRaisedException(ob);
@@ -6,11 +6,24 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
-/* Captures the result of a function, either a value or error. */
+/*
+ * Captures the result of a function, either a value or error. Errors
+ * from the kernel are kept as plain errno values until they are raised.
+ */
 typedef struct {
     PyObject *value;
 } Outcome;
 
+/* Decoded strerror() messages, built on first use for every errno. */
+#define ERRNO_CACHE_SIZE 256
+
+typedef struct {
+    PyObject *messages[ERRNO_CACHE_SIZE];
+} ErrnoCache;
+
+/* Releases all messages held by the cache. */
+void errno_cache_clear(ErrnoCache *cache);
+
 /* Initializes an empty outcome object. */
 void outcome_init(Outcome *outcome);
 
@@ -34,5 +47,8 @@ void outcome_capture_error(Outcome *outcome);
 /* Captures the current errno value into the outcome. */
 void outcome_capture_errno(Outcome *outcome);
 
+/* Takes the value or error object out of the outcome without raising. */
+PyObject *outcome_take(Outcome *outcome, ErrnoCache *cache);
+
 /* Unwraps the outcome, either returning a value or raising an error. */
-PyObject *outcome_unwrap(Outcome *outcome);
+PyObject *outcome_unwrap(Outcome *outcome, ErrnoCache *cache);
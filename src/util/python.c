@@ -29,6 +29,38 @@ void python_tp_dealloc(PyObject *self) {
     }
 }
 
+void python_stop_iteration(PyObject *res) {
+    if (Py_IsNone(res)) {
+        Py_DECREF(res);
+        return;
+    }
+
+    PyObject *args[2] = {NULL, res};
+    size_t nargsf     = 1 | PY_VECTORCALL_ARGUMENTS_OFFSET;
+
+    PyObject *exc = PyObject_Vectorcall(PyExc_StopIteration, args + 1, nargsf, NULL);
+    Py_DECREF(res);
+    if (exc != NULL) {
+        PyErr_SetRaisedException(exc);
+    }
+}
+
+bool python_get_buffer(Py_buffer *view, PyObject *ob, bool writable, size_t nbytes) {
+    int flags = writable ? PyBUF_WRITABLE : PyBUF_SIMPLE;
+    if (PyObject_GetBuffer(ob, view, flags) < 0) {
+        view->obj = NULL;
+        return false;
+    }
+
+    if ((size_t)view->len < nbytes) {
+        PyErr_Format(PyExc_ValueError, "Buffer of %zd bytes is too small for %zu bytes", view->len, nbytes);
+        PyBuffer_Release(view);
+        return false;
+    }
+
+    return true;
+}
+
 bool python_parse_int(int *out, PyObject *ob) {
     int overflow;
     long tmp = PyLong_AsLongAndOverflow(ob, &overflow);
@@ -70,3 +102,13 @@ bool python_parse_unsigned_long_long(unsigned long long *out, PyObject *ob) {
     *out = tmp;
     return true;
 }
+
+bool python_parse_bool(bool *out, PyObject *ob) {
+    int tmp = PyObject_IsTrue(ob);
+    if (tmp < 0) {
+        return false;
+    }
+
+    *out = tmp != 0;
+    return true;
+}
@@ -15,9 +15,29 @@ static inline PyObject *python_alloc(PyTypeObject *tp) {
     return tp_alloc(tp, 0);
 }
 
+/* Releases the buffer export held by view, if there is one. */
+static inline void python_release_buffer(Py_buffer *view) {
+    if (view->obj != NULL) {
+        PyBuffer_Release(view);
+    }
+}
+
+/*
+ * Exports a contiguous buffer from ob into view and checks that it holds
+ * at least nbytes. With writable, the buffer must accept writes too.
+ */
+bool python_get_buffer(Py_buffer *view, PyObject *ob, bool writable, size_t nbytes);
+
 /* Reusable PyObject tp_dealloc slot for custom types. */
 void python_tp_dealloc(PyObject *self);
 
+/*
+ * Ends an iterator with res as its return value, consuming the reference.
+ * None needs no StopIteration at all, the interpreter assumes it as the
+ * value when an iterator is exhausted without an exception set.
+ */
+void python_stop_iteration(PyObject *res);
+
 /* Attempts to parse a given PyObject into a C int value. */
 bool python_parse_int(int *out, PyObject *ob);
 
@@ -26,3 +46,6 @@ bool python_parse_unsigned_int(unsigned int *out, PyObject *ob);
 
 /* Attempts to parse a given PyObject into a C unsigned long long value. */
 bool python_parse_unsigned_long_long(unsigned long long *out, PyObject *ob);
+
+/* Attempts to parse a given PyObject into a C bool based on its truthiness. */
+bool python_parse_bool(bool *out, PyObject *ob);
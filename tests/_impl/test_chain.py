@@ -0,0 +1,83 @@
+import errno
+import os
+import tempfile
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+
+
+class TestChain:
+    def test_chain_results(self, cfg):
+        async def go():
+            return await _impl.chain([_impl.nop(1), _impl.nop(2), _impl.nop(3)])
+
+        assert run(cfg, go()) == (1, 2, 3)
+
+    def test_chain_failure_cancels_rest(self, cfg):
+        async def go():
+            return await _impl.chain([_impl.nop(-errno.EIO), _impl.nop(2)])
+
+        first, second = run(cfg, go())
+        assert first == -errno.EIO
+        assert isinstance(second, OSError)
+        assert second.errno == errno.ECANCELED
+
+    def test_chain_hard_link(self, cfg):
+        async def go():
+            return await _impl.chain([_impl.nop(-errno.EIO), _impl.nop(2)], True)
+
+        assert run(cfg, go()) == (-errno.EIO, 2)
+
+    def test_chain_write_read_close(self, cfg):
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "chain.bin")
+
+        async def go():
+            fd = await _impl.openat(
+                None, path, os.O_CREAT | os.O_RDWR | os.O_TRUNC, 0o644
+            )
+            return await _impl.chain(
+                (
+                    _impl.write(fd, b"linked", 0),
+                    _impl.read(fd, 16, 0),
+                    _impl.close(fd),
+                )
+            )
+
+        assert run(cfg, go()) == (6, b"linked", 0)
+        os.unlink(path)
+        os.rmdir(tmp)
+
+    def test_chained_operation_cannot_be_reused(self, cfg):
+        async def go():
+            op = _impl.nop(1)
+            await _impl.chain([op])
+            await _impl.chain([op])
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+    def test_chain_duplicate_operation(self, cfg):
+        async def go():
+            op = _impl.nop(1)
+            await _impl.chain([op, op])
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+    def test_chain_longer_than_queue(self, cfg):
+        async def go():
+            await _impl.chain([_impl.nop(i) for i in range(cfg.sq_size + 1)])
+
+        with pytest.raises(ValueError):
+            run(cfg, go())
+
+    def test_chain_rejects_bad_links(self):
+        with pytest.raises(ValueError):
+            _impl.chain([])
+        with pytest.raises(TypeError):
+            _impl.chain([object()])  # type: ignore[list-item]
+        with pytest.raises(TypeError):
+            _impl.chain([_impl.accept_multishot(0, 0)])  # type: ignore[list-item]
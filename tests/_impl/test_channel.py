@@ -0,0 +1,216 @@
+import gc
+import os
+import queue
+import tempfile
+import threading
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+
+
+class TestChannel:
+    def test_message_to_own_runtime(self, cfg):
+        async def go():
+            ch = _impl.channel()
+            await _impl.msg_ring(ch, 42)
+            return await ch
+
+        assert run(cfg, go()) == 42
+
+    def test_messages_are_buffered_in_order(self, cfg):
+        async def go():
+            ch = _impl.channel()
+            for i in range(40):
+                await _impl.msg_ring(ch, i)
+
+            # Let the last completion arrive before looking at the count.
+            await _impl.nop(None)
+            pending = ch.pending
+            return pending, [await ch for _ in range(40)]
+
+        pending, received = run(cfg, go())
+        assert pending == 40
+        assert received == list(range(40))
+
+    def test_waiter_wakes_on_message(self, cfg):
+        async def send(ch):
+            await _impl.sleep(0.01)
+            await _impl.msg_ring(ch, -7)
+
+        async def go():
+            ch = _impl.channel()
+            sender = _impl.spawn(send(ch))
+            message = await ch
+            await sender
+            return message
+
+        assert run(cfg, go()) == -7
+
+    def test_dropped_channel_releases_waiters(self, cfg):
+        tasks = {}
+
+        async def park():
+            await _impl.channel()
+
+        async def first():
+            await tasks["second"]
+
+        async def second():
+            await tasks["first"]
+
+        async def go():
+            _impl.spawn(park())
+            await _impl.nop(None)
+
+            # Nothing can send to the channel, so it is collected along
+            # with the task waiting on it. What is left is a deadlock.
+            gc.collect()
+
+            tasks["first"] = _impl.spawn(first())
+            tasks["second"] = _impl.spawn(second())
+            await tasks["first"]
+
+        with pytest.raises(RuntimeError, match="Deadlock"):
+            run(cfg, go())
+
+    def test_message_across_threads(self, cfg):
+        channels = queue.Queue()
+        received = []
+
+        async def receive():
+            ch = _impl.channel()
+            channels.put(ch)
+            for _ in range(3):
+                received.append(await ch)
+
+        receiver = threading.Thread(target=run, args=(cfg, receive()))
+        receiver.start()
+        ch = channels.get()
+
+        async def send():
+            for i in range(3):
+                await _impl.msg_ring(ch, i)
+
+        run(cfg, send())
+        receiver.join()
+        assert received == [0, 1, 2]
+
+    def test_receive_on_other_runtime(self, cfg):
+        async def make():
+            return _impl.channel()
+
+        ch = run(cfg, make())
+
+        async def go():
+            await ch
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+    def test_not_a_channel(self, cfg):
+        async def go():
+            await _impl.msg_ring(object(), 1)
+
+        with pytest.raises(TypeError):
+            run(cfg, go())
+
+    def test_outside_runtime(self):
+        with pytest.raises(RuntimeError):
+            _impl.channel()
+
+
+class TestHandoff:
+    def test_send_fd_moves_descriptor(self, cfg):
+        cfg.ftable_size = 8
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "handoff.bin")
+        with open(path, "wb") as f:
+            f.write(b"handed off")
+
+        channels = queue.Queue()
+        outcomes = queue.Queue()
+
+        async def work():
+            ch = _impl.channel()
+            channels.put(ch)
+
+            # The only task waits for a descriptor from the other thread.
+            fd = await ch
+            data = await _impl.read(fd, 64, 0, True)
+            await _impl.close(fd, True)
+            ch.release()
+            return data, ch.load
+
+        def worker():
+            try:
+                outcomes.put(run(cfg, work()))
+            except BaseException as e:
+                outcomes.put(e)
+
+        workers = [threading.Thread(target=worker, daemon=True) for _ in range(2)]
+        for thread in workers:
+            thread.start()
+        d = _impl.dispatcher([channels.get(timeout=5), channels.get(timeout=5)])
+
+        async def accept():
+            results = []
+            for _ in range(2):
+                fd = await _impl.openat(None, path, os.O_RDONLY, 0, True)
+                handoff = _impl.send_fd(d.pick(), fd)
+                results.append(await _impl.chain([handoff, _impl.close(fd, True)]))
+            return results
+
+        try:
+            assert run(cfg, accept()) == [(None, 0), (None, 0)]
+            received = [outcomes.get(timeout=5) for _ in workers]
+        finally:
+            os.unlink(path)
+            os.rmdir(tmp)
+
+        for thread in workers:
+            thread.join(timeout=5)
+        assert received == [(b"handed off", 0)] * 2
+
+    def test_send_fd_not_a_channel(self, cfg):
+        async def go():
+            await _impl.send_fd(None, 0)
+
+        with pytest.raises(TypeError):
+            run(cfg, go())
+
+
+class TestDispatcher:
+    def test_round_robin(self, cfg):
+        async def go():
+            channels = [_impl.channel() for _ in range(3)]
+            d = _impl.dispatcher(channels)
+            picks = [d.pick() for _ in range(7)]
+            return [channels.index(ch) for ch in picks]
+
+        assert run(cfg, go()) == [0, 1, 2, 0, 1, 2, 0]
+
+    def test_least_loaded_ties_rotate(self, cfg):
+        async def go():
+            channels = [_impl.channel() for _ in range(3)]
+            d = _impl.dispatcher(channels, True)
+            picks = [d.pick() for _ in range(4)]
+            return [channels.index(ch) for ch in picks]
+
+        assert run(cfg, go()) == [0, 1, 2, 0]
+
+    def test_release_without_load(self, cfg):
+        async def go():
+            ch = _impl.channel()
+            assert ch.load == 0
+            ch.release()
+
+        with pytest.raises(ValueError):
+            run(cfg, go())
+
+    def test_invalid_channels(self):
+        with pytest.raises(ValueError):
+            _impl.dispatcher([])
+        with pytest.raises(TypeError):
+            _impl.dispatcher([object()])
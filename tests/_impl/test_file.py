@@ -1,3 +1,4 @@
+import errno
 import os
 import pathlib
 import tempfile
@@ -78,7 +79,7 @@ class TestFileOps:
             _impl.openat(None, "/tmp/x")  # type: ignore[missing-argument]  # too few
 
         with pytest.raises(TypeError):
-            _impl.openat(None, "/tmp/x", 0, 0, 0)  # type: ignore[too-many-positional-arguments]  # too many
+            _impl.openat(None, "/tmp/x", 0, 0, False, 0)  # type: ignore[too-many-positional-arguments]  # too many
 
     def test_openat_bad_path_type(self):
         with pytest.raises(TypeError):
@@ -91,6 +92,36 @@ class TestFileOps:
         with pytest.raises(OSError):
             run(cfg, go())
 
+    def test_failed_completion_picks_oserror_subclass(self, cfg):
+        async def go():
+            for _ in range(2):
+                with pytest.raises(FileNotFoundError) as exc:
+                    await _impl.openat(None, "/nonexistent/boros", os.O_RDONLY, 0)
+                assert exc.value.errno == errno.ENOENT
+                assert exc.value.strerror == os.strerror(errno.ENOENT)
+
+        run(cfg, go())
+
+    def test_write_buffer_objects(self, cfg):
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "buffers.bin")
+
+        async def go():
+            fd = await _impl.openat(
+                None, path, os.O_CREAT | os.O_RDWR | os.O_TRUNC, 0o644
+            )
+
+            frame = bytearray(b"header:payload")
+            assert await _impl.write(fd, frame, 0) == len(frame)
+            assert await _impl.write(fd, memoryview(frame)[7:], 0) == 7
+            assert await _impl.read(fd, 64, 0) == b"payload:payload"
+
+            await _impl.close(fd)
+
+        run(cfg, go())
+        os.unlink(path)
+        os.rmdir(tmp)
+
     def test_write_requires_bytes(self):
         with pytest.raises(TypeError):
             _impl.write(0, "string", 0)  # type: ignore[invalid-argument-type]
@@ -145,3 +176,181 @@ class TestFileOps:
         run(cfg, go())
         os.unlink(path)
         os.rmdir(tmp)
+
+
+class TestReadInto:
+    def test_readinto_bytearray(self, cfg):
+        tmp = tempfile.NamedTemporaryFile(delete=False)
+        tmp.write(b"0123456789")
+        tmp.close()
+
+        async def go():
+            fd = await _impl.openat(None, tmp.name, os.O_RDONLY, 0)
+
+            buf = bytearray(16)
+            assert await _impl.readinto(fd, buf, 16, 0) == 10
+            assert buf[:10] == b"0123456789"
+
+            view = memoryview(buf)[4:8]
+            assert await _impl.readinto(fd, view, 4, 2) == 4
+            assert buf[:10] == b"0123234589"
+            view.release()
+
+            await _impl.close(fd)
+
+        try:
+            run(cfg, go())
+        finally:
+            os.unlink(tmp.name)
+
+    def test_readinto_locks_buffer(self, cfg):
+        async def go():
+            buf = bytearray(8)
+            op = _impl.readinto(0, buf, 8, 0)
+            with pytest.raises(BufferError):
+                buf.extend(b"x")
+            del op
+            buf.extend(b"x")
+
+        run(cfg, go())
+
+    def test_readinto_rejects_bad_buffers(self):
+        with pytest.raises(BufferError):
+            _impl.readinto(0, b"readonly", 8, 0)
+        with pytest.raises(ValueError):
+            _impl.readinto(0, bytearray(4), 8, 0)
+
+
+class TestVectored:
+    def test_writev_readv(self, cfg):
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "vectored.bin")
+
+        async def go():
+            fd = await _impl.openat(
+                None, path, os.O_CREAT | os.O_RDWR | os.O_TRUNC, 0o644
+            )
+            parts = [b"head", bytearray(b"-body-"), memoryview(b"xtail")[1:]]
+            assert await _impl.writev(fd, parts, 0) == 14
+
+            a, b = bytearray(4), bytearray(16)
+            assert await _impl.readv(fd, (a, b), 0) == 14
+            assert a == b"head"
+            assert b[:10] == b"-body-tail"
+
+            await _impl.close(fd)
+
+        try:
+            run(cfg, go())
+        finally:
+            os.unlink(path)
+            os.rmdir(tmp)
+
+    def test_vectored_rejects_bad_sequences(self):
+        with pytest.raises(ValueError):
+            _impl.writev(0, [], 0)
+        with pytest.raises(BufferError):
+            _impl.readv(0, [bytearray(4), b"readonly"], 0)
+        with pytest.raises(TypeError):
+            _impl.writev(0, 42, 0)
+
+
+class TestFixedBuffers:
+    def test_write_read_fixed(self, cfg):
+        cfg.fbuf_count = 2
+        cfg.fbuf_size = 4096
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "fixed.bin")
+
+        async def go():
+            data = b"registered buffers"
+
+            fd = await _impl.openat(
+                None, path, os.O_CREAT | os.O_RDWR | os.O_TRUNC, 0o644
+            )
+            with _impl.lease_fixed() as src:
+                assert len(src) == 4096
+                memoryview(src)[: len(data)] = data
+                assert await _impl.write_fixed(fd, src, len(data), 0) == len(data)
+
+            with _impl.lease_fixed() as dst:
+                n = await _impl.read_fixed(fd, dst, 4096, 0)
+                assert bytes(memoryview(dst)[:n]) == data
+            await _impl.close(fd)
+
+        run(cfg, go())
+        os.unlink(path)
+        os.rmdir(tmp)
+
+    def test_lease_fixed_exhaustion(self, cfg):
+        cfg.fbuf_count = 1
+
+        async def go():
+            buf = _impl.lease_fixed()
+            with pytest.raises(OSError):
+                _impl.lease_fixed()
+            buf.release()
+            _impl.lease_fixed().release()
+
+        run(cfg, go())
+
+    def test_pinned_buffer_cannot_be_released(self, cfg):
+        cfg.fbuf_count = 1
+
+        async def go():
+            buf = _impl.lease_fixed()
+            op = _impl.read_fixed(0, buf, 1, 0)
+            with pytest.raises(BufferError):
+                buf.release()
+            del op
+            buf.release()
+
+        run(cfg, go())
+
+    def test_fixed_ops_reject_other_buffers(self, cfg):
+        cfg.fbuf_count = 1
+
+        async def go():
+            with pytest.raises(TypeError):
+                _impl.read_fixed(0, bytearray(16), 16, 0)
+            with _impl.lease_fixed() as buf:
+                with pytest.raises(ValueError):
+                    _impl.write_fixed(0, buf, len(buf) + 1, 0)
+
+        run(cfg, go())
+
+    def test_lease_fixed_requires_pool(self, cfg):
+        async def go():
+            _impl.lease_fixed()
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+
+class TestDirectDescriptors:
+    def test_openat_direct(self, cfg):
+        cfg.ftable_size = 8
+        tmp = tempfile.mkdtemp()
+        path = os.path.join(tmp, "direct.bin")
+
+        async def go():
+            data = b"direct descriptors"
+
+            fd = await _impl.openat(
+                None, path, os.O_CREAT | os.O_RDWR | os.O_TRUNC, 0o644, True
+            )
+            assert 0 <= fd < 8
+            assert await _impl.write(fd, data, 0, True) == len(data)
+            assert await _impl.read(fd, 4096, 0, True) == data
+            await _impl.close(fd, True)
+
+        run(cfg, go())
+        os.unlink(path)
+        os.rmdir(tmp)
+
+    def test_openat_direct_without_table(self, cfg):
+        async def go():
+            await _impl.openat(None, "/", os.O_RDONLY, 0, True)
+
+        with pytest.raises(OSError):
+            run(cfg, go())
@@ -24,3 +24,11 @@ class TestNop:
     def test_nop_overflow(self):
         with pytest.raises(OverflowError):
             _impl.nop(2**64)
+
+    def test_nop_is_its_own_awaitable(self, cfg):
+        async def go():
+            op = _impl.nop(7)
+            assert op.__await__() is op
+            return await op
+
+        assert run(cfg, go()) == 7
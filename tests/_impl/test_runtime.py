@@ -1,3 +1,6 @@
+import os
+import threading
+
 import pytest
 
 from boros import _impl
@@ -62,3 +65,123 @@ class TestRuntime:
 
         assert run(cfg, first()) == 1
         assert run(cfg, second()) == 2
+
+    def test_operations_are_recycled(self, cfg):
+        async def go():
+            for i in range(16):
+                assert await _impl.nop(i) == i
+
+        before = _impl.freelist_stats()
+        run(cfg, go())
+        after = _impl.freelist_stats()
+
+        assert after["hits"] > before["hits"]
+        assert after["cached"] >= 1
+
+    def test_wait_lets_other_threads_run(self, cfg):
+        r, w = os.pipe()
+        waiting = threading.Event()
+        ran = threading.Event()
+
+        # Only runs Python code once the loop is about to block on the pipe.
+        def other():
+            waiting.wait()
+            ran.set()
+            os.write(w, b"x")
+
+        async def go():
+            thread = threading.Thread(target=other)
+            thread.start()
+            waiting.set()
+            # With the GIL held while waiting, the write never happens.
+            data = await _impl.timeout(_impl.read(r, 1, -1), 10)
+            thread.join()
+            return data
+
+        try:
+            assert run(cfg, go()) == b"x"
+            assert ran.is_set()
+        finally:
+            os.close(r)
+            os.close(w)
+
+
+def open_fds():
+    return len(os.listdir("/proc/self/fd"))
+
+
+class TestPersistentRuntime:
+    @pytest.fixture
+    def pcfg(self, cfg):
+        cfg.persistent = True
+        yield cfg
+        _impl.shutdown()
+
+    def test_ring_is_reused(self, pcfg):
+        async def go(n):
+            return await _impl.nop(n)
+
+        before = open_fds()
+        assert run(pcfg, go(1)) == 1
+        kept = open_fds()
+        assert kept > before
+
+        for i in range(8):
+            assert run(pcfg, go(i)) == i
+        assert open_fds() == kept
+
+        _impl.shutdown()
+        assert open_fds() == before
+
+    def test_incompatible_config_replaces_runtime(self, pcfg):
+        async def go():
+            return await _impl.nop(0)
+
+        run(pcfg, go())
+        kept = open_fds()
+
+        other = _impl.RunConfig()
+        other.sq_size = 32
+        other.persistent = True
+        run(other, go())
+        assert open_fds() == kept
+
+    def test_idle_runtime_is_not_active(self, pcfg):
+        async def go():
+            return await _impl.nop(0)
+
+        run(pcfg, go())
+        with pytest.raises(RuntimeError):
+            _impl.channel()
+
+    def test_direct_descriptors_do_not_leak(self, pcfg):
+        pcfg.ftable_size = 1
+
+        async def go():
+            # Left open on purpose, the slot is the only one in the table.
+            return await _impl.openat(None, "/", os.O_RDONLY, 0, True)
+
+        assert run(pcfg, go()) == 0
+        assert run(pcfg, go()) == 0
+
+    def test_channels_of_earlier_runs_go_stale(self, pcfg):
+        async def make():
+            return _impl.channel()
+
+        ch = run(pcfg, make())
+
+        async def go():
+            await ch
+
+        with pytest.raises(RuntimeError):
+            run(pcfg, go())
+
+    def test_shutdown_inside_run(self, pcfg):
+        async def go():
+            _impl.shutdown()
+
+        with pytest.raises(RuntimeError):
+            run(pcfg, go())
+
+    def test_shutdown_without_runtime(self):
+        _impl.shutdown()
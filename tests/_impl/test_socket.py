@@ -103,3 +103,371 @@ class TestSockopt:
     def test_getsockopt_wrong_arg_count(self):
         with pytest.raises(TypeError):
             _impl.getsockopt(0, socket.SOL_SOCKET)  # type: ignore[no-matching-overload]
+
+
+async def _tcp_pair():
+    srv = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+    await _impl.setsockopt(srv, socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    await _impl.bind(srv, socket.AF_INET, ("127.0.0.1", 0))
+
+    s = socket.socket(fileno=os.dup(srv))
+    port = s.getsockname()[1]
+    s.close()
+
+    await _impl.listen(srv, 5)
+
+    cli = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+    await _impl.connect(cli, socket.AF_INET, ("127.0.0.1", port))
+    acc, _ = await _impl.accept(srv, 0)
+
+    return srv, cli, acc
+
+
+class TestProvidedBuffers:
+    def test_recv_buffer(self, cfg):
+        cfg.pbuf_count = 4
+        cfg.pbuf_size = 64
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"hello", 0)
+            with await _impl.recv_buffer(acc, 0) as buf:
+                assert len(buf) == 5
+                assert bytes(buf) == b"hello"
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_released_buffers_are_recycled(self, cfg):
+        cfg.pbuf_count = 1
+        cfg.pbuf_size = 16
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            for i in range(8):
+                msg = str(i).encode()
+                await _impl.send(cli, msg, 0)
+
+                buf = await _impl.recv_buffer(acc, 0)
+                assert bytes(buf) == msg
+                buf.release()
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_exported_buffer_cannot_be_released(self, cfg):
+        cfg.pbuf_count = 2
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"data", 0)
+            buf = await _impl.recv_buffer(acc, 0)
+
+            view = memoryview(buf)
+            with pytest.raises(BufferError):
+                buf.release()
+            view.release()
+            buf.release()
+
+            with pytest.raises(ValueError):
+                memoryview(buf)
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_lease_outlives_runtime(self, cfg):
+        cfg.pbuf_count = 2
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"keep", 0)
+            buf = await _impl.recv_buffer(acc, 0)
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+            return buf
+
+        buf = run(cfg, go())
+        assert bytes(buf) == b"keep"
+        buf.release()
+
+    def test_recv_buffer_requires_pool(self, cfg):
+        async def go():
+            _impl.recv_buffer(0, 0)
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+
+class TestRecvInto:
+    def test_recv_into(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"hello", 0)
+            buf = bytearray(b"." * 8)
+            assert await _impl.recv_into(acc, memoryview(buf)[2:], 6, 0) == 5
+            assert buf == b"..hello."
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_send_buffer_objects(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            frame = bytearray(b"xxhello")
+            assert await _impl.send(cli, memoryview(frame)[2:], 0) == 5
+            assert await _impl.recv(acc, 16, 0) == b"hello"
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+
+class TestMessages:
+    def test_sendmsg_recvmsg(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            assert await _impl.sendmsg(cli, [b"hel", bytearray(b"lo")], 0) == 5
+            head, tail = bytearray(2), bytearray(3)
+            assert await _impl.recvmsg(acc, [head, tail], socket.MSG_WAITALL) == 5
+            assert head == b"he"
+            assert tail == b"llo"
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+
+class TestMultishotAccept:
+    def test_accept_multishot(self, cfg):
+        async def go():
+            srv = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            await _impl.bind(srv, socket.AF_INET, ("127.0.0.1", 0))
+
+            s = socket.socket(fileno=os.dup(srv))
+            port = s.getsockname()[1]
+            s.close()
+
+            await _impl.listen(srv, 8)
+
+            clients = []
+            for _ in range(3):
+                cli = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+                await _impl.connect(cli, socket.AF_INET, ("127.0.0.1", port))
+                clients.append(cli)
+
+            accepted = []
+            async for fd, addr in _impl.accept_multishot(srv, 0, True):
+                assert fd >= 0
+                assert addr is None or addr[0] == "127.0.0.1"
+                accepted.append(fd)
+                if len(accepted) == len(clients):
+                    break
+
+            for fd in accepted + clients + [srv]:
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_multishot_is_its_own_anext_awaitable(self, cfg):
+        async def go():
+            srv = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            op = _impl.accept_multishot(srv, 0)
+
+            with pytest.raises(TypeError):
+                await op
+
+            # Iterating hands out the operation itself, nothing is allocated.
+            assert op.__anext__() is op
+            await _impl.close(srv)
+
+        run(cfg, go())
+
+    def test_armed_multishot_at_shutdown(self, cfg):
+        async def go():
+            srv = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            await _impl.bind(srv, socket.AF_INET, ("127.0.0.1", 0))
+
+            s = socket.socket(fileno=os.dup(srv))
+            port = s.getsockname()[1]
+            s.close()
+
+            await _impl.listen(srv, 8)
+
+            cli = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            await _impl.connect(cli, socket.AF_INET, ("127.0.0.1", port))
+
+            # Leave the operation armed in the kernel on purpose.
+            async for fd, addr in _impl.accept_multishot(srv, 0):
+                # Peer addresses are only looked up on request.
+                assert addr is None
+                await _impl.close(fd)
+                break
+
+            await _impl.close(cli)
+            return srv
+
+        srv = run(cfg, go())
+        os.close(srv)
+
+    def test_accept_multishot_not_awaitable(self, cfg):
+        async def go():
+            await _impl.accept_multishot(0, 0)  # type: ignore[invalid-await]
+
+        with pytest.raises(TypeError):
+            run(cfg, go())
+
+
+class TestMultishotRecv:
+    def test_recv_multishot(self, cfg):
+        cfg.pbuf_count = 4
+        cfg.pbuf_size = 64
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"hello ", 0)
+            await _impl.send(cli, b"world", 0)
+            await _impl.close(cli)
+
+            data = b""
+            async for buf in _impl.recv_multishot(acc, 0):
+                with buf:
+                    data += bytes(buf)
+
+            assert data == b"hello world"
+
+            for fd in (acc, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_recv_multishot_rearms_after_exhaustion(self, cfg):
+        cfg.pbuf_count = 1
+        cfg.pbuf_size = 4
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            payload = b"0123456789abcdef"
+            await _impl.send(cli, payload, 0)
+
+            data = b""
+            async for buf in _impl.recv_multishot(acc, 0):
+                data += bytes(buf)
+                buf.release()
+                if len(data) == len(payload):
+                    break
+
+            assert data == payload
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_recv_multishot_requires_pool(self, cfg):
+        async def go():
+            _impl.recv_multishot(0, 0)
+
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+
+class TestZeroCopySend:
+    def test_send_zc(self, cfg):
+        cfg.pbuf_count = 4
+        cfg.pbuf_size = 4096
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            payload = bytearray(b"z" * 4096)
+            assert await _impl.send_zc(cli, payload, 0) == len(payload)
+            await _impl.close(cli)
+
+            received = 0
+            async for buf in _impl.recv_multishot(acc, 0):
+                with buf:
+                    received += len(buf)
+            assert received == len(payload)
+
+            for fd in (acc, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_send_zc_locks_buffer(self, cfg):
+        async def go():
+            payload = bytearray(16)
+            op = _impl.send_zc(0, payload, 0)
+            with pytest.raises(BufferError):
+                payload.extend(b"x")
+            del op
+            payload.extend(b"x")
+
+        run(cfg, go())
+
+    def test_send_zc_rejects_non_buffer(self):
+        with pytest.raises(TypeError):
+            _impl.send_zc(0, "text", 0)  # type: ignore[invalid-argument-type]
+
+
+class TestDirectSockets:
+    def test_socket_direct_echo(self, cfg):
+        cfg.ftable_size = 8
+
+        async def go():
+            srv = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            await _impl.bind(srv, socket.AF_INET, ("127.0.0.1", 0))
+
+            s = socket.socket(fileno=os.dup(srv))
+            port = s.getsockname()[1]
+            s.close()
+
+            await _impl.listen(srv, 5)
+
+            cli = await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0)
+            await _impl.connect(cli, socket.AF_INET, ("127.0.0.1", port))
+
+            acc, _ = await _impl.accept(srv, 0, True)
+            assert 0 <= acc < 8
+
+            await _impl.send(cli, b"ping", 0)
+            assert await _impl.recv(acc, 16, 0, True) == b"ping"
+            await _impl.send(acc, b"pong", 0, True)
+            assert await _impl.recv(cli, 16, 0) == b"pong"
+
+            await _impl.close(acc, True)
+            for fd in (cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_socket_direct_alloc(self, cfg):
+        cfg.ftable_size = 2
+
+        async def go():
+            fds = [await _impl.socket(socket.AF_INET, socket.SOCK_STREAM, 0, True) for _ in range(2)]
+            assert sorted(fds) == [0, 1]
+            for fd in fds:
+                await _impl.close(fd, True)
+
+        run(cfg, go())
@@ -0,0 +1,153 @@
+import errno
+import os
+import socket
+import tempfile
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+from .test_socket import _tcp_pair
+
+
+def _shutdown_write(fd):
+    with socket.socket(fileno=os.dup(fd)) as s:
+        s.shutdown(socket.SHUT_WR)
+
+
+class TestSplice:
+    def test_splice_file_into_pipe(self, cfg):
+        tmp = tempfile.NamedTemporaryFile(delete=False)
+        tmp.write(b"0123456789")
+        tmp.close()
+
+        async def go():
+            fd = await _impl.openat(None, tmp.name, os.O_RDONLY, 0)
+            r, w = os.pipe()
+
+            assert await _impl.splice(fd, 2, w, -1, 6, 0) == 6
+            assert os.read(r, 16) == b"234567"
+
+            for p in (fd, r, w):
+                await _impl.close(p)
+
+        try:
+            run(cfg, go())
+        finally:
+            os.unlink(tmp.name)
+
+    def test_tee_duplicates_pipe_data(self, cfg):
+        async def go():
+            r1, w1 = os.pipe()
+            r2, w2 = os.pipe()
+            os.write(w1, b"hello")
+
+            assert await _impl.tee(r1, w2, 16, 0) == 5
+            assert os.read(r1, 16) == b"hello"
+            assert os.read(r2, 16) == b"hello"
+
+            for p in (r1, w1, r2, w2):
+                await _impl.close(p)
+
+        run(cfg, go())
+
+    def test_splice_rejects_bad_offsets(self):
+        with pytest.raises(ValueError):
+            _impl.splice(0, -2, 1, -1, 8, 0)
+
+
+
+class TestSendfile:
+    def test_sendfile_file_range(self, cfg):
+        data = os.urandom(96 * 1024)
+        tmp = tempfile.NamedTemporaryFile(delete=False)
+        tmp.write(data)
+        tmp.close()
+
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+            # The whole range has to fit into the socket buffers, since
+            # nobody reads from the other end until the transfer is done.
+            await _impl.setsockopt(cli, socket.SOL_SOCKET, socket.SO_SNDBUF, 1 << 20)
+            await _impl.setsockopt(acc, socket.SOL_SOCKET, socket.SO_RCVBUF, 1 << 20)
+
+            fd = await _impl.openat(None, tmp.name, os.O_RDONLY, 0)
+            count = len(data) - 10
+            assert await _impl.sendfile(cli, fd, 10, count) == count
+            # Running past the end of the file stops early.
+            assert await _impl.sendfile(cli, fd, len(data) - 4, 100) == 4
+            _shutdown_write(cli)
+
+            received = bytearray()
+            while chunk := await _impl.recv(acc, 65536, 0):
+                received += chunk
+            assert received == data[10:] + data[-4:]
+
+            for p in (fd, acc, cli, srv):
+                await _impl.close(p)
+
+        try:
+            run(cfg, go())
+        finally:
+            os.unlink(tmp.name)
+
+    def test_sendfile_reports_errors(self, cfg):
+        async def go():
+            with pytest.raises(OSError) as e:
+                await _impl.sendfile(-1, -1, 0, 16)
+            assert e.value.errno == errno.EBADF
+
+        run(cfg, go())
+
+    def test_sendfile_rejects_empty_ranges(self):
+        with pytest.raises(ValueError):
+            _impl.sendfile(1, 0, 0, 0)
+
+
+class TestRelay:
+    def test_relay_both_directions(self, cfg):
+        async def go():
+            srv1, a_cli, a_acc = await _tcp_pair()
+            srv2, b_cli, b_acc = await _tcp_pair()
+
+            # Both peers finish sending before the relay starts, so it
+            # forwards everything and then passes the end of file on.
+            payload = os.urandom(32768)
+            await _impl.send(a_cli, b"ping", 0)
+            _shutdown_write(a_cli)
+            await _impl.send(b_acc, payload, 0)
+            _shutdown_write(b_acc)
+
+            assert await _impl.relay(a_acc, b_cli) == (4, len(payload))
+
+            assert await _impl.recv(b_acc, 16, 0) == b"ping"
+            assert await _impl.recv(b_acc, 16, 0) == b""
+
+            received = bytearray()
+            while chunk := await _impl.recv(a_cli, 65536, 0):
+                received += chunk
+            assert received == payload
+
+            for fd in (a_cli, a_acc, srv1, b_cli, b_acc, srv2):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_relay_reports_errors(self, cfg):
+        async def go():
+            with pytest.raises(OSError) as e:
+                await _impl.relay(-1, -1)
+            assert e.value.errno == errno.EBADF
+
+        run(cfg, go())
+
+    def test_relay_cannot_be_chained(self):
+        r, w = os.pipe()
+        try:
+            with pytest.raises(TypeError):
+                _impl.chain([_impl.relay(r, w)])
+            with pytest.raises(TypeError):
+                _impl.timeout(_impl.relay(r, w), 1.0)
+        finally:
+            os.close(r)
+            os.close(w)
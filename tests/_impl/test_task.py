@@ -0,0 +1,263 @@
+import sysconfig
+import threading
+import types
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+
+FREE_THREADED = bool(sysconfig.get_config_var("Py_GIL_DISABLED"))
+
+
+class TestSpawn:
+    def test_spawn_and_join(self, cfg):
+        async def child(n):
+            await _impl.nop(None)
+            return n * 2
+
+        async def go():
+            tasks = [_impl.spawn(child(i)) for i in range(8)]
+            return [await t for t in tasks]
+
+        assert run(cfg, go()) == [i * 2 for i in range(8)]
+
+    def test_tasks_run_concurrently(self, cfg):
+        order = []
+
+        async def child(name, delay):
+            await _impl.sleep(delay)
+            order.append(name)
+
+        async def go():
+            slow = _impl.spawn(child("slow", 0.05))
+            fast = _impl.spawn(child("fast", 0.01))
+            await slow
+            await fast
+
+        run(cfg, go())
+        assert order == ["fast", "slow"]
+
+    def test_join_finished_task_repeatedly(self, cfg):
+        async def child():
+            return "done"
+
+        async def go():
+            task = _impl.spawn(child(), "worker")
+            assert task.name == "worker"
+            assert not task.done
+
+            await _impl.nop(None)
+            assert task.done
+            return await task, await task
+
+        assert run(cfg, go()) == ("done", "done")
+
+    def test_many_waiters(self, cfg):
+        async def child():
+            await _impl.sleep(0.01)
+            return 7
+
+        async def waiter(task):
+            return await task + 1
+
+        async def go():
+            task = _impl.spawn(child())
+            waiters = [_impl.spawn(waiter(task)) for _ in range(4)]
+            return [await w for w in waiters]
+
+        assert run(cfg, go()) == [8, 8, 8, 8]
+
+    def test_join_propagates_exception(self, cfg):
+        async def child():
+            await _impl.nop(None)
+            raise ValueError("boom")
+
+        async def go():
+            task = _impl.spawn(child())
+            with pytest.raises(ValueError, match="boom"):
+                await task
+
+        run(cfg, go())
+
+    def test_spawn_requires_runtime(self):
+        async def child():
+            pass
+
+        coro = child()
+        with pytest.raises(RuntimeError):
+            _impl.spawn(coro)
+        coro.close()
+
+    def test_spawn_requires_coroutine(self, cfg):
+        async def go():
+            with pytest.raises(TypeError):
+                _impl.spawn(lambda: None)
+
+        run(cfg, go())
+
+
+class TestBudgets:
+    def test_bare_yield_reschedules(self, cfg):
+        log = []
+
+        @types.coroutine
+        def yield_now():
+            yield
+
+        async def other():
+            log.append("other")
+
+        async def go():
+            _impl.spawn(other())
+            log.append("before")
+            await yield_now()
+            log.append("after")
+
+        run(cfg, go())
+        assert log == ["before", "other", "after"]
+
+    def test_task_budget_forces_yield(self, cfg):
+        cfg.task_budget = 4
+        log = []
+
+        async def child():
+            return 1
+
+        async def other():
+            log.append("other")
+
+        async def go():
+            task = _impl.spawn(child())
+            await _impl.nop(None)
+            assert task.done
+
+            # Joining a finished task never suspends, until the budget
+            # runs out and the task has to give the others a turn.
+            _impl.spawn(other())
+            for _ in range(10):
+                log.append(await task)
+
+        run(cfg, go())
+        assert log.index("other") == 4
+        assert log.count(1) == 10
+
+    def test_step_budget_keeps_order(self, cfg):
+        cfg.step_budget = 2
+        log = []
+
+        async def child(n):
+            log.append(n)
+
+        async def go():
+            tasks = [_impl.spawn(child(n)) for n in range(7)]
+            for t in tasks:
+                await t
+
+        run(cfg, go())
+        assert log == list(range(7))
+
+
+class TestLifoSlot:
+    def test_woken_task_runs_first(self, cfg):
+        log = []
+
+        async def child(n):
+            await _impl.nop(None)
+            log.append(n)
+
+        async def go():
+            tasks = [_impl.spawn(child(n)) for n in range(4)]
+            for t in tasks:
+                await t
+
+        run(cfg, go())
+        assert log == [3, 0, 1, 2]
+
+    def test_lifo_slot_is_capped(self, cfg):
+        cfg.step_budget = 1
+        log = []
+
+        @types.coroutine
+        def yield_now():
+            yield
+
+        async def other():
+            while len(log) < 8:
+                log.append("other")
+                await yield_now()
+
+        async def go():
+            _impl.spawn(other())
+            for i in range(6):
+                await _impl.nop(None)
+                log.append(i)
+
+        run(cfg, go())
+        assert log[:5] == [0, 1, 2, "other", 3]
+
+
+class TestWorkers:
+    def test_workers_must_not_be_zero(self, cfg):
+        async def go():
+            pass
+
+        cfg.workers = 0
+        with pytest.raises(ValueError):
+            run(cfg, go())
+
+    @pytest.mark.skipif(FREE_THREADED, reason="requires a GIL build")
+    def test_workers_require_free_threading(self, cfg):
+        async def go():
+            pass
+
+        cfg.workers = 2
+        with pytest.raises(RuntimeError):
+            run(cfg, go())
+
+    @pytest.mark.skipif(not FREE_THREADED, reason="requires a free-threaded build")
+    def test_registered_resources_are_rejected(self, cfg):
+        async def go():
+            pass
+
+        cfg.workers = 2
+        cfg.ftable_size = 8
+        with pytest.raises(ValueError):
+            run(cfg, go())
+
+    @pytest.mark.skipif(not FREE_THREADED, reason="requires a free-threaded build")
+    def test_tasks_spread_across_workers(self, cfg):
+        cfg.workers = 4
+        threads = set()
+
+        async def child(n):
+            for _ in range(10):
+                await _impl.sleep(0.001)
+                threads.add(threading.get_ident())
+            return n
+
+        async def go():
+            tasks = [_impl.spawn(child(n)) for n in range(32)]
+            return [await t for t in tasks]
+
+        assert run(cfg, go()) == list(range(32))
+        assert len(threads) > 1
+
+    @pytest.mark.skipif(not FREE_THREADED, reason="requires a free-threaded build")
+    def test_deadlock_across_workers(self, cfg):
+        cfg.workers = 2
+        tasks = {}
+
+        async def first():
+            await tasks["second"]
+
+        async def second():
+            await tasks["first"]
+
+        async def go():
+            tasks["first"] = _impl.spawn(first())
+            tasks["second"] = _impl.spawn(second())
+            await tasks["first"]
+
+        with pytest.raises(RuntimeError, match="Deadlock"):
+            run(cfg, go())
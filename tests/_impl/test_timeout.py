@@ -0,0 +1,105 @@
+import os
+import socket
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+from .test_socket import _tcp_pair
+
+
+class TestLinkTimeout:
+    def test_timeout_not_reached(self, cfg):
+        async def go():
+            return await _impl.timeout(_impl.nop(5), 10)
+
+        assert run(cfg, go()) == 5
+
+    def test_timeout_expires(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            with pytest.raises(TimeoutError):
+                await _impl.timeout(_impl.recv(acc, 16, 0), 0.05)
+
+            # The connection is still usable after the timeout.
+            await _impl.send(cli, b"late", 0)
+            assert await _impl.recv(acc, 16, 0) == b"late"
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_timeout_in_chain(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            results = await _impl.chain(
+                [_impl.timeout(_impl.recv(acc, 16, 0), 0.05), _impl.nop(1)], True
+            )
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+            return results
+
+        first, second = run(cfg, go())
+        assert isinstance(first, TimeoutError)
+        assert second == 1
+
+    def test_data_arrives_before_timeout(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            await _impl.send(cli, b"x", 0)
+            assert await _impl.timeout(_impl.recv(acc, 16, 0), 10) == b"x"
+
+            for fd in (acc, cli, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_timeout_on_zero_copy_send(self, cfg):
+        async def go():
+            srv, cli, acc = await _tcp_pair()
+
+            # Fill the socket buffers so that the next send has to wait.
+            s = socket.socket(fileno=os.dup(cli))
+            s.setblocking(False)
+            try:
+                while True:
+                    s.send(b"x" * 65536)
+            except BlockingIOError:
+                pass
+            finally:
+                s.close()
+
+            payload = bytearray(65536)
+            with pytest.raises(TimeoutError):
+                await _impl.timeout(_impl.send_zc(cli, payload, 0), 0.05)
+
+            # The notification releases the buffer once the kernel is done.
+            await _impl.close(cli)
+            for _ in range(100):
+                try:
+                    payload.extend(b"x")
+                    break
+                except BufferError:
+                    await _impl.sleep(0.01)
+            else:
+                pytest.fail("buffer was never released")
+
+            for fd in (acc, srv):
+                await _impl.close(fd)
+
+        run(cfg, go())
+
+    def test_timeout_rejects_bad_values(self):
+        with pytest.raises(ValueError):
+            _impl.timeout(_impl.nop(0), -1)
+        with pytest.raises(ValueError):
+            _impl.timeout(_impl.nop(0), float("inf"))
+        with pytest.raises(TypeError):
+            _impl.timeout(object(), 1)  # type: ignore[invalid-argument-type]
+        with pytest.raises(TypeError):
+            _impl.timeout(_impl.accept_multishot(0, 0), 1)  # type: ignore[invalid-argument-type]
@@ -0,0 +1,54 @@
+import time
+
+import pytest
+
+from boros import _impl
+from .conftest import run
+
+
+class TestSleep:
+    def test_sleep(self, cfg):
+        async def go():
+            start = time.monotonic()
+            await _impl.sleep(0.05)
+            return time.monotonic() - start
+
+        assert run(cfg, go()) >= 0.05
+
+    def test_sleep_until(self, cfg):
+        async def go():
+            deadline = time.monotonic() + 0.03
+            await _impl.sleep_until(deadline)
+            return time.monotonic() - deadline
+
+        assert run(cfg, go()) >= 0
+
+    def test_sleep_zero_yields(self, cfg):
+        async def go():
+            assert await _impl.sleep(0) is None
+            assert await _impl.sleep(-1) is None
+            assert await _impl.sleep_until(0) is None
+
+        run(cfg, go())
+
+    def test_sleep_with_pending_io(self, cfg):
+        async def go():
+            await _impl.sleep(0.01)
+            assert await _impl.nop(3) == 3
+            await _impl.sleep(0.01)
+
+        run(cfg, go())
+
+    def test_sleep_rejects_bad_values(self):
+        with pytest.raises(ValueError):
+            _impl.sleep(float("nan"))
+        with pytest.raises(ValueError):
+            _impl.sleep_until(float("inf"))
+        with pytest.raises(TypeError):
+            _impl.sleep("1")  # type: ignore[invalid-argument-type]
+
+    def test_sleep_cannot_be_linked(self):
+        with pytest.raises(TypeError):
+            _impl.timeout(_impl.sleep(1), 1)
+        with pytest.raises(TypeError):
+            _impl.chain([_impl.sleep(1)])